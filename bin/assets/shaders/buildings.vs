@@ -1,9 +1,28 @@
 #version 330 core
   
 layout (location = 0) in vec3 vertex;
-layout (location = 1) in vec3 position;
+layout (location = 1) in vec2 tile;
+// Width, level, length
 layout (location = 2) in vec3 size;
+layout (location = 3) in vec3 normal;
+
+uniform mat4 transform;
+
+out vec3 lighting;
+
+const float margin = 0.2f;
+
+const vec3 lightDir = vec3(-1, 0.7f, 0.8f);
+const vec3 lightColor = vec3(0.95f, 0.95f, 0.95f);
+const float ambientStrength = 0.7f;
+const float diffuseStrength = 0.3f;
 
 void main() {
-  gl_Position = vec4(vertex * size + position, 1.0);
+  // Empty instances have zero size and stay degenerate
+  vec3 position = vec3(tile.x + margin, 0, tile.y + margin);
+  vec3 scale = max(size - vec3(2 * margin, 0, 2 * margin), vec3(0));
+  gl_Position = transform * vec4(vertex * scale + position, 1.0);
+
+  // Scaling keeps normals of the box, faces are flat so lighting per vertex is exact
+  lighting = (ambientStrength + diffuseStrength * max(dot(normal, lightDir), 0.0)) * lightColor;
 }
\ No newline at end of file
@@ -0,0 +1,15 @@
+#version 330 core
+  
+layout (location = 0) in vec3 vertex;
+layout (location = 1) in vec2 tile;
+// Width, level, length
+layout (location = 2) in vec3 size;
+
+const float margin = 0.2f;
+
+void main() {
+  // Empty instances have zero size and stay degenerate
+  vec3 position = vec3(tile.x + margin, 0, tile.y + margin);
+  vec3 scale = max(size - vec3(2 * margin, 0, 2 * margin), vec3(0));
+  gl_Position = vec4(vertex * scale + position, 1.0);
+}
\ No newline at end of file
@@ -2,13 +2,15 @@
 
 uniform sampler2D groundTexture;
 uniform sampler2DArray roadTexture;
+uniform usampler2DArray tileTexture;
 
 uniform bool renderGrid;
 uniform ivec4 selection;
 uniform vec4 selectionColor;
 
 in vec3 vPos;
-flat in int vTile;
+in vec2 vLocal;
+flat in int vLayer;
 
 out vec4 color;
 
@@ -23,10 +25,12 @@ void main() {
   vec2 textureSize = vec2(1 / atlasSide, 1 / atlasSide);
   vec2 textureInnerMovement = vec2(1 / (2 * atlasSidePx), 1 / (2 * atlasSidePx));
   vec2 textureInnerSize = textureSize - vec2(1 / atlasSidePx, 1 / atlasSidePx);
+  // Far edges of the chunk belong to the last tile
+  int tile = int(texelFetch(tileTexture, ivec3(min(ivec2(vLocal), ivec2(63)), vLayer), 0).r) - 1;
   vec2 tilePos = vPos.xz - ivec2(vPos.xz);
-  vec2 texturePos = vec2(int(vTile) % int(atlasSide), floor(vTile / atlasSide)) * textureSize + textureInnerMovement + tilePos * textureInnerSize;
+  vec2 texturePos = vec2(tile % int(atlasSide), floor(tile / atlasSide)) * textureSize + textureInnerMovement + tilePos * textureInnerSize;
   vec4 roadColor = texture(roadTexture, vec3(texturePos, 0));
-  color = vec4(mix(color.xyz, roadColor.xyz, int(vTile > -1) * roadColor.w), 1);
+  color = vec4(mix(color.xyz, roadColor.xyz, int(tile > -1) * roadColor.w), 1);
 
   if (renderGrid) {
     vec4 gridColor = texture(groundTexture, vPos.xz / 16.f + vec2(0.5, 0.5) / 512.f);
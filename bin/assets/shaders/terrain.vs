@@ -1,14 +1,17 @@
 #version 330 core
   
 layout (location = 0) in vec3 vertex;
-layout (location = 1) in float tile;
+// Offset of the chunk in xy, its layer of tile texture in z
+layout (location = 1) in vec3 chunk;
 
 uniform mat4 transform;
 out vec3 vPos;
-flat out int vTile;
+out vec2 vLocal;
+flat out int vLayer;
 
 void main() {
-  vPos = vertex;
-  vTile = int(tile) - 1;
+  vPos = vertex + vec3(chunk.x, 0, chunk.y);
+  vLocal = vertex.xz;
+  vLayer = int(chunk.z);
   gl_Position = transform * vec4(vPos, 1.0);
 }
\ No newline at end of file
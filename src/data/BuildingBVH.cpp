@@ -0,0 +1,176 @@
+#include "BuildingBVH.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace data {
+
+constexpr int BuildingBVH::NONE;
+
+void BuildingBVH::add(const buildings::Building& building, unsigned int index) {
+  const glm::vec3 from = glm::vec3(building.x, 0, building.y);
+  const Box box = {from, from + glm::vec3(building.width, building.level, building.length)};
+
+  const int leaf = allocateNode();
+  nodes[leaf] = Node{box, NONE, NONE, NONE, (int)index};
+  if (leaves.size() <= index) {
+    leaves.resize(index + 1, NONE);
+  }
+  leaves[index] = leaf;
+
+  if (root == NONE) {
+    root = leaf;
+    return;
+  }
+
+  // Descend towards the sibling whose box grows the least, stopping when new parent here is cheaper
+  int sibling = root;
+  while (nodes[sibling].building == NONE) {
+    const Node& node = nodes[sibling];
+    const float combined = getArea(merge(node.box, box));
+    const float inherited = 2 * (combined - getArea(node.box));
+    float childCost[2];
+    const int children[2] = {node.left, node.right};
+    for (int i = 0; i < 2; i++) {
+      const Box& childBox = nodes[children[i]].box;
+      childCost[i] = getArea(merge(childBox, box)) + inherited;
+      if (nodes[children[i]].building == NONE) {
+        childCost[i] -= getArea(childBox);
+      }
+    }
+    if (2 * combined < childCost[0] && 2 * combined < childCost[1]) {
+      break;
+    }
+    sibling = (childCost[0] < childCost[1]) ? children[0] : children[1];
+  }
+
+  const int oldParent = nodes[sibling].parent;
+  const int parent = allocateNode();
+  nodes[parent] = Node{merge(nodes[sibling].box, box), oldParent, sibling, leaf, NONE};
+  nodes[sibling].parent = parent;
+  nodes[leaf].parent = parent;
+  if (oldParent == NONE) {
+    root = parent;
+  } else if (nodes[oldParent].left == sibling) {
+    nodes[oldParent].left = parent;
+  } else {
+    nodes[oldParent].right = parent;
+  }
+  refit(oldParent);
+}
+
+void BuildingBVH::remove(unsigned int index, unsigned int moved) {
+  const int leaf = leaves[index];
+  const int parent = nodes[leaf].parent;
+  if (parent == NONE) {
+    root = NONE;
+  } else {
+    // Sibling takes place of the parent
+    const int sibling = (nodes[parent].left == leaf) ? nodes[parent].right : nodes[parent].left;
+    const int grandparent = nodes[parent].parent;
+    nodes[sibling].parent = grandparent;
+    if (grandparent == NONE) {
+      root = sibling;
+    } else if (nodes[grandparent].left == parent) {
+      nodes[grandparent].left = sibling;
+    } else {
+      nodes[grandparent].right = sibling;
+    }
+    refit(grandparent);
+    freeNodes.push_back(parent);
+  }
+  freeNodes.push_back(leaf);
+
+  leaves[index] = leaves[moved];
+  nodes[leaves[index]].building = index;
+  leaves.pop_back();
+}
+
+bool BuildingBVH::getBounds(glm::vec3& min, glm::vec3& max) const {
+  if (root == NONE) {
+    return false;
+  }
+  min = nodes[root].box.min;
+  max = nodes[root].box.max;
+  return true;
+}
+
+bool BuildingBVH::raycast(glm::vec3 origin, glm::vec3 direction, float& distance, unsigned int& index) const {
+  const glm::vec3 inverse = 1.f / direction;
+  float entry;
+  if (root == NONE || !hitBox(nodes[root].box, origin, inverse, distance, entry)) {
+    return false;
+  }
+
+  // Nodes with their entry distances, nearer child is visited first
+  bool found = false;
+  std::vector<std::pair<int, float>> stack;
+  stack.push_back(std::make_pair(root, entry));
+  while (!stack.empty()) {
+    const std::pair<int, float> top = stack.back();
+    stack.pop_back();
+    if (distance <= top.second) {
+      continue;
+    }
+
+    const Node& node = nodes[top.first];
+    if (node.building != NONE) {
+      distance = top.second;
+      index = node.building;
+      found = true;
+      continue;
+    }
+
+    float leftEntry, rightEntry;
+    const bool leftHit = hitBox(nodes[node.left].box, origin, inverse, distance, leftEntry);
+    const bool rightHit = hitBox(nodes[node.right].box, origin, inverse, distance, rightEntry);
+    if (leftHit && rightHit) {
+      const bool leftFirst = leftEntry <= rightEntry;
+      stack.push_back(leftFirst ? std::make_pair(node.right, rightEntry) : std::make_pair(node.left, leftEntry));
+      stack.push_back(leftFirst ? std::make_pair(node.left, leftEntry) : std::make_pair(node.right, rightEntry));
+    } else if (leftHit) {
+      stack.push_back(std::make_pair(node.left, leftEntry));
+    } else if (rightHit) {
+      stack.push_back(std::make_pair(node.right, rightEntry));
+    }
+  }
+  return found;
+}
+
+int BuildingBVH::allocateNode() {
+  if (freeNodes.empty()) {
+    nodes.push_back(Node());
+    return nodes.size() - 1;
+  }
+  const int node = freeNodes.back();
+  freeNodes.pop_back();
+  return node;
+}
+
+void BuildingBVH::refit(int node) {
+  while (node != NONE) {
+    nodes[node].box = merge(nodes[nodes[node].left].box, nodes[nodes[node].right].box);
+    node = nodes[node].parent;
+  }
+}
+
+BuildingBVH::Box BuildingBVH::merge(const Box& a, const Box& b) {
+  return Box{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+float BuildingBVH::getArea(const Box& box) {
+  const glm::vec3 size = box.max - box.min;
+  return 2 * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+bool BuildingBVH::hitBox(const Box& box, glm::vec3 origin, glm::vec3 inverse, float limit, float& entry) {
+  // Slab test, ray starting inside the box enters it at 0
+  const glm::vec3 t1 = (box.min - origin) * inverse;
+  const glm::vec3 t2 = (box.max - origin) * inverse;
+  const glm::vec3 near = glm::min(t1, t2);
+  const glm::vec3 far = glm::max(t1, t2);
+  entry = std::max(std::max(near.x, near.y), std::max(near.z, 0.f));
+  const float exit = std::min(std::min(far.x, far.y), far.z);
+  return entry <= exit && entry < limit;
+}
+}
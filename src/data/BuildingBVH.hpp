@@ -0,0 +1,63 @@
+#ifndef DATA_BUILDINGBVH_HPP
+#define DATA_BUILDINGBVH_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "buildings.hpp"
+
+namespace data {
+
+/**
+ * Bounding volume hierarchy over 3D boxes of buildings of a single chunk, used for picking. Box spans building
+ * footprint and `level` units up. Edits insert or unlink single leaf and refit its ancestors, tree is never rebuilt.
+ */
+class BuildingBVH {
+
+public:
+  void add(const buildings::Building& building, unsigned int index);
+  // Building with index `moved` takes index of the removed one
+  void remove(unsigned int index, unsigned int moved);
+
+  /**
+   * Finds building hit first by ray `origin + t * direction`, t >= 0.
+   *
+   * @param distance limit of t on input, t of the hit on output
+   * @return false if nothing is hit before the limit
+   */
+  bool raycast(glm::vec3 origin, glm::vec3 direction, float& distance, unsigned int& index) const;
+
+  // Box around all buildings, false if there are none
+  bool getBounds(glm::vec3& min, glm::vec3& max) const;
+
+private:
+  constexpr static int NONE = -1;
+
+  struct Box {
+    glm::vec3 min;
+    glm::vec3 max;
+  };
+
+  struct Node {
+    Box box;
+    int parent;
+    int left;
+    int right;
+    // Building index in leaves, NONE otherwise
+    int building;
+  };
+
+  std::vector<Node> nodes;
+  std::vector<int> freeNodes;
+  std::vector<int> leaves;
+  int root = NONE;
+
+  int allocateNode();
+  void refit(int node);
+  static Box merge(const Box& a, const Box& b);
+  static float getArea(const Box& box);
+  static bool hitBox(const Box& box, glm::vec3 origin, glm::vec3 inverse, float limit, float& entry);
+};
+}
+
+#endif
@@ -0,0 +1,130 @@
+#include "BuildingIndex.hpp"
+
+#include "Chunk.hpp"
+
+namespace data {
+
+namespace {
+constexpr int CELLS_PER_SIDE = Chunk::SIDE_LENGTH / BuildingIndex::CELL_SIZE;
+}
+
+constexpr int BuildingIndex::CELL_SIZE;
+
+void BuildingIndex::setChunk(glm::ivec2 chunkPosition) {
+  origin = chunkPosition * (int)Chunk::SIDE_LENGTH;
+  cells.assign(CELLS_PER_SIDE * CELLS_PER_SIDE, std::vector<unsigned int>());
+  for (unsigned int i = 0; i < rects.size(); i++) {
+    for (int x = getCell(rects[i].from).x; x <= getCell(rects[i].to).x; x++) {
+      for (int y = getCell(rects[i].from).y; y <= getCell(rects[i].to).y; y++) {
+        getCellList(glm::ivec2(x, y)).push_back(i);
+      }
+    }
+  }
+}
+
+void BuildingIndex::add(const buildings::Building& building, unsigned int index) {
+  const glm::ivec2 from = glm::ivec2(building.x, building.y);
+  const Rect rect = {from, from + glm::ivec2(building.width, building.length) - glm::ivec2(1, 1)};
+  if (rects.size() <= index) {
+    rects.resize(index + 1);
+  }
+  rects[index] = rect;
+
+  const glm::ivec2 cellFrom = getCell(rect.from);
+  const glm::ivec2 cellTo = getCell(rect.to);
+  for (int x = cellFrom.x; x <= cellTo.x; x++) {
+    for (int y = cellFrom.y; y <= cellTo.y; y++) {
+      getCellList(glm::ivec2(x, y)).push_back(index);
+    }
+  }
+
+  if (rects.size() == 1) {
+    bounds = rect;
+  } else {
+    bounds.from = glm::min(bounds.from, rect.from);
+    bounds.to = glm::max(bounds.to, rect.to);
+  }
+}
+
+void BuildingIndex::remove(unsigned int index, unsigned int moved) {
+  for (unsigned int id : {index, moved}) {
+    const glm::ivec2 cellFrom = getCell(rects[id].from);
+    const glm::ivec2 cellTo = getCell(rects[id].to);
+    for (int x = cellFrom.x; x <= cellTo.x; x++) {
+      for (int y = cellFrom.y; y <= cellTo.y; y++) {
+        std::vector<unsigned int>& list = getCellList(glm::ivec2(x, y));
+        if (id == index) {
+          list.erase(std::remove(list.begin(), list.end(), index), list.end());
+        } else {
+          std::replace(list.begin(), list.end(), moved, index);
+        }
+      }
+    }
+  }
+
+  // Bounds are not shrunk, staying conservative
+  rects[index] = rects[moved];
+  rects.pop_back();
+}
+
+bool BuildingIndex::any(glm::ivec2 from, glm::ivec2 to) const {
+  const Rect area = {from, to};
+  if (rects.empty() || !overlap(bounds, area)) {
+    return false;
+  }
+
+  const glm::ivec2 cellFrom = getCell(from);
+  const glm::ivec2 cellTo = getCell(to);
+  for (int x = cellFrom.x; x <= cellTo.x; x++) {
+    for (int y = cellFrom.y; y <= cellTo.y; y++) {
+      for (unsigned int index : getCellList(glm::ivec2(x, y))) {
+        if (overlap(rects[index], area)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+void BuildingIndex::query(glm::ivec2 from, glm::ivec2 to, std::vector<unsigned int>& result) const {
+  const Rect area = {from, to};
+  if (rects.empty() || !overlap(bounds, area)) {
+    return;
+  }
+
+  const glm::ivec2 cellFrom = getCell(from);
+  const glm::ivec2 cellTo = getCell(to);
+  for (int x = cellFrom.x; x <= cellTo.x; x++) {
+    for (int y = cellFrom.y; y <= cellTo.y; y++) {
+      for (unsigned int index : getCellList(glm::ivec2(x, y))) {
+        const Rect& rect = rects[index];
+        if (!overlap(rect, area)) {
+          continue;
+        }
+        // Report building only in the first cell shared by building and query
+        const glm::ivec2 first = glm::max(getCell(rect.from), cellFrom);
+        if (first.x == x && first.y == y) {
+          result.push_back(index);
+        }
+      }
+    }
+  }
+}
+
+glm::ivec2 BuildingIndex::getCell(glm::ivec2 global) const {
+  return glm::clamp((global - origin) / CELL_SIZE, glm::ivec2(0, 0), glm::ivec2(CELLS_PER_SIDE - 1));
+}
+
+std::vector<unsigned int>& BuildingIndex::getCellList(glm::ivec2 cell) {
+  return cells[cell.y * CELLS_PER_SIDE + cell.x];
+}
+
+const std::vector<unsigned int>& BuildingIndex::getCellList(glm::ivec2 cell) const {
+  return cells[cell.y * CELLS_PER_SIDE + cell.x];
+}
+
+bool BuildingIndex::overlap(const Rect& a, const Rect& b) const {
+  return !(a.to.x < b.from.x || b.to.x < a.from.x || a.to.y < b.from.y || b.to.y < a.from.y);
+}
+}
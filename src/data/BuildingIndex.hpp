@@ -0,0 +1,51 @@
+#ifndef DATA_BUILDINGINDEX_HPP
+#define DATA_BUILDINGINDEX_HPP
+
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "buildings.hpp"
+
+namespace data {
+
+/**
+ * Uniform grid over buildings of a single chunk. Buildings are identified by their index in chunk. Parts of buildings
+ * sticking out of the chunk are kept in border cells, so queries are clamped the same way.
+ */
+class BuildingIndex {
+
+public:
+  constexpr static int CELL_SIZE = 8;
+
+  void setChunk(glm::ivec2 chunkPosition);
+
+  void add(const buildings::Building& building, unsigned int index);
+  // Building with index `moved` takes index of the removed one
+  void remove(unsigned int index, unsigned int moved);
+
+  // Both take inclusive rectangle in global coordinates
+  bool any(glm::ivec2 from, glm::ivec2 to) const;
+  // Appends indices of intersecting buildings, each once
+  void query(glm::ivec2 from, glm::ivec2 to, std::vector<unsigned int>& result) const;
+
+private:
+  struct Rect {
+    glm::ivec2 from;
+    glm::ivec2 to;
+  };
+
+  glm::ivec2 origin;
+  std::vector<std::vector<unsigned int>> cells;
+  std::vector<Rect> rects;
+  // Union of all buildings, for rejecting whole chunk
+  Rect bounds;
+
+  glm::ivec2 getCell(glm::ivec2 global) const;
+  std::vector<unsigned int>& getCellList(glm::ivec2 cell);
+  const std::vector<unsigned int>& getCellList(glm::ivec2 cell) const;
+  bool overlap(const Rect& a, const Rect& b) const;
+};
+}
+
+#endif
@@ -5,7 +5,8 @@ namespace data {
 Chunk::Chunk() {
   objectId = 0;
   position = glm::ivec2();
-  residentialSize = 0;
+  buildingIndex.setChunk(position);
+  frontageIndex.rebuild(roadGraph, lots, position);
 }
 
 void Chunk::setObjectId(unsigned int objectId) {
@@ -14,9 +15,8 @@ void Chunk::setObjectId(unsigned int objectId) {
 
 void Chunk::setPosition(glm::ivec2 position) {
   this->position = position;
-  if (position == glm::ivec2(0, 0)) {
-    roadGraph.test();
-  }
+  buildingIndex.setChunk(position);
+  frontageIndex.rebuild(roadGraph, lots, position);
 }
 
 glm::ivec2 Chunk::getPosition() const {
@@ -32,19 +32,26 @@ Chunk::residentialListIter Chunk::getResidentialIterator() const {
 }
 
 unsigned int Chunk::getResidentialSize() const {
-  return residentialSize;
+  return residential.size();
 }
 
 void Chunk::addLot(data::Lot lot) {
   lots.push_back(lot);
+  frontageIndex.addLot(lot);
 }
 
 Chunk::lotList Chunk::getLots() const {
   return lots;
 }
 
+void Chunk::stitchLots(const std::vector<const Chunk*>& neighbours) {
+  frontageIndex.stitch(neighbours);
+}
+
 void Chunk::addBuilding(data::buildings::Building building) {
   residential.push_back(building);
+  buildingIndex.add(building, residential.size() - 1);
+  buildingBVH.add(building, residential.size() - 1);
 }
 
 bool Chunk::removeBuilding(data::buildings::Building building) {
@@ -57,19 +64,81 @@ bool Chunk::removeBuilding(data::buildings::Building building) {
   if (toRemove == residential.end()) {
     return false;
   }
-  residential.erase(toRemove);
+
+  // Last building fills the gap, so only two index entries change
+  const unsigned int index = toRemove - residential.begin();
+  const unsigned int last = residential.size() - 1;
+  buildingIndex.remove(index, last);
+  buildingBVH.remove(index, last);
+  residential[index] = residential[last];
+  residential.pop_back();
+  return true;
+}
+
+void Chunk::getBuildings(glm::ivec2 from, glm::ivec2 to, std::vector<data::buildings::Building>& result) const {
+  std::vector<unsigned int> indices;
+  buildingIndex.query(from, to, indices);
+  for (unsigned int index : indices) {
+    result.push_back(residential[index]);
+  }
+}
+
+bool Chunk::hasBuildings(glm::ivec2 from, glm::ivec2 to) const {
+  return buildingIndex.any(from, to);
+}
+
+bool Chunk::hitBuilding(glm::vec3 origin, glm::vec3 direction, float& distance, buildings::Building& hit) const {
+  unsigned int index;
+  if (!buildingBVH.raycast(origin, direction, distance, index)) {
+    return false;
+  }
+  hit = residential[index];
   return true;
 }
 
+void Chunk::getBounds(glm::vec3& min, glm::vec3& max) const {
+  min = glm::vec3(position.x, 0, position.y) * (float)SIDE_LENGTH;
+  max = min + glm::vec3(1, 0, 1) * (float)SIDE_LENGTH;
+  glm::vec3 buildingsMin, buildingsMax;
+  if (buildingBVH.getBounds(buildingsMin, buildingsMax)) {
+    min = glm::min(min, buildingsMin);
+    max = glm::max(max, buildingsMax);
+  }
+}
+
 void Chunk::addRoad(Road road) {
   roadGraph.addRoad(road);
+  frontageIndex.rebuild(roadGraph, lots, position);
+}
+
+void Chunk::addRoads(const std::vector<Road>& roads) {
+  roadGraph.addRoads(roads);
+  frontageIndex.rebuild(roadGraph, lots, position);
+}
+
+void Chunk::setRoads(const std::vector<Road>& roads) {
+  roadGraph = RoadGraph();
+  addRoads(roads);
 }
 
 const std::vector<Road>& Chunk::getRoads() const {
   return roadGraph.getRoads();
 }
 
+void Chunk::stitchRoads(const std::vector<const Chunk*>& neighbours) {
+  std::vector<const RoadGraph*> graphs;
+  for (const Chunk* neighbour : neighbours) {
+    graphs.push_back(&neighbour->getRoadGraph());
+  }
+  roadGraph.stitch(graphs);
+  frontageIndex.stitch(neighbours);
+}
+
 const RoadGraph& Chunk::getRoadGraph() const {
   return roadGraph;
 }
+
+const FrontageIndex& Chunk::getFrontageIndex() const {
+  return frontageIndex;
+}
 }
\ No newline at end of file
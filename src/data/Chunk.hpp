@@ -5,6 +5,9 @@
 #include <glm/glm.hpp>
 #include <vector>
 
+#include "BuildingBVH.hpp"
+#include "BuildingIndex.hpp"
+#include "FrontageIndex.hpp"
 #include "Lot.hpp"
 #include "Road.hpp"
 #include "RoadGraph.hpp"
@@ -21,6 +24,9 @@ public:
   constexpr unsigned static int SIDE_LENGTH = 64;
 
   Chunk();
+  // Frontage index points into road graph of the chunk, so a copy would point into the source
+  Chunk(const Chunk&) = delete;
+  Chunk& operator=(const Chunk&) = delete;
   void setObjectId(unsigned int objectId);
 
   void setPosition(glm::ivec2 position);
@@ -32,25 +38,41 @@ public:
 
   void addLot(data::Lot lot);
   lotList getLots() const;
+  // Links lots and roads facing each other across chunk border, see FrontageIndex::stitch()
+  void stitchLots(const std::vector<const Chunk*>& neighbours);
 
   void addBuilding(data::buildings::Building building);
   bool removeBuilding(data::buildings::Building building);
+  // Inclusive rectangle in global coordinates
+  void getBuildings(glm::ivec2 from, glm::ivec2 to, std::vector<data::buildings::Building>& result) const;
+  bool hasBuildings(glm::ivec2 from, glm::ivec2 to) const;
+  // See BuildingBVH::raycast()
+  bool hitBuilding(glm::vec3 origin, glm::vec3 direction, float& distance, buildings::Building& hit) const;
+  // Box around ground of the chunk and its buildings, in world space
+  void getBounds(glm::vec3& min, glm::vec3& max) const;
 
   void addRoad(Road road);
+  void addRoads(const std::vector<Road>& roads);
+  // Replaces all roads of the chunk
+  void setRoads(const std::vector<Road>& roads);
   const std::vector<Road>& getRoads() const;
+  void stitchRoads(const std::vector<const Chunk*>& neighbours);
 
   const RoadGraph& getRoadGraph() const;
+  const FrontageIndex& getFrontageIndex() const;
 
 private:
   unsigned int objectId;
   glm::ivec2 position;
 
   std::vector<data::buildings::Building> residential;
-  unsigned int residentialSize;
+  BuildingIndex buildingIndex;
+  BuildingBVH buildingBVH;
 
   std::vector<data::Lot> lots;
 
   RoadGraph roadGraph;
+  FrontageIndex frontageIndex;
 };
 }
 
@@ -0,0 +1,85 @@
+#ifndef DATA_FENWICKTABLE_HPP
+#define DATA_FENWICKTABLE_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace data {
+
+/**
+ * 2D Fenwick tree, sum over any rectangle and change of single cell both take O(log(width) * log(height)). Unlike
+ * SummedAreaTable, suited for grids edited between queries.
+ */
+template <typename T> class FenwickTable {
+
+public:
+  void reset(glm::ivec2 size) {
+    this->size = size;
+    tree.assign(size.x * size.y, 0);
+  }
+
+  glm::ivec2 getSize() const {
+    return size;
+  }
+
+  // Adds grid of given size, stored row by row. Tree is linear in values, so this works for deltas too.
+  void add(const std::vector<T>& values) {
+    std::vector<T> added = values;
+    for (int y = 0; y < size.y; y++) {
+      for (int x = 1; x <= size.x; x++) {
+        const int parent = x + (x & -x);
+        if (parent <= size.x) {
+          added[y * size.x + parent - 1] += added[y * size.x + x - 1];
+        }
+      }
+    }
+    for (int x = 0; x < size.x; x++) {
+      for (int y = 1; y <= size.y; y++) {
+        const int parent = y + (y & -y);
+        if (parent <= size.y) {
+          added[(parent - 1) * size.x + x] += added[(y - 1) * size.x + x];
+        }
+      }
+    }
+    for (unsigned int i = 0; i < tree.size(); i++) {
+      tree[i] += added[i];
+    }
+  }
+
+  void add(glm::ivec2 cell, T value) {
+    for (int y = cell.y + 1; y <= size.y; y += y & -y) {
+      for (int x = cell.x + 1; x <= size.x; x += x & -x) {
+        tree[(y - 1) * size.x + x - 1] += value;
+      }
+    }
+  }
+
+  // Inclusive rectangle in grid coordinates, clamped to the grid
+  T getSum(glm::ivec2 from, glm::ivec2 to) const {
+    from = glm::max(from, glm::ivec2(0, 0));
+    to = glm::min(to, size - glm::ivec2(1, 1));
+    if (to.x < from.x || to.y < from.y) {
+      return 0;
+    }
+    return getPrefix(to + glm::ivec2(1, 1)) - getPrefix(glm::ivec2(from.x, to.y + 1)) -
+           getPrefix(glm::ivec2(to.x + 1, from.y)) + getPrefix(from);
+  }
+
+private:
+  glm::ivec2 size = glm::ivec2(0, 0);
+  std::vector<T> tree;
+
+  // Sum of cells before given one in both coordinates
+  T getPrefix(glm::ivec2 end) const {
+    T sum = 0;
+    for (int y = end.y; y > 0; y -= y & -y) {
+      for (int x = end.x; x > 0; x -= x & -x) {
+        sum += tree[(y - 1) * size.x + x - 1];
+      }
+    }
+    return sum;
+  }
+};
+}
+
+#endif
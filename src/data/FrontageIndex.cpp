@@ -0,0 +1,164 @@
+#include "FrontageIndex.hpp"
+
+#include "Chunk.hpp"
+
+namespace data {
+
+void FrontageIndex::rebuild(const RoadGraph& graph, const std::vector<Lot>& lots, glm::ivec2 chunkPosition) {
+  this->graph = &graph;
+  origin = chunkPosition * (int)Chunk::SIDE_LENGTH;
+
+  roadAt.assign(Chunk::SIDE_LENGTH * Chunk::SIDE_LENGTH, -1);
+  nodeAt.assign(Chunk::SIDE_LENGTH * Chunk::SIDE_LENGTH, -1);
+  const std::vector<Road>& roads = graph.getRoads();
+  for (unsigned int i = 0; i < roads.size(); i++) {
+    paint(roadAt, roads[i].position.getGlobal(), roads[i].getEnd(), i);
+  }
+  const std::vector<RoadGraph::Node>& nodes = graph.getNodes();
+  for (unsigned int i = 0; i < nodes.size(); i++) {
+    paint(nodeAt, nodes[i].position.getGlobal(), nodes[i].position.getGlobal() + nodes[i].size - glm::ivec2(1, 1), i);
+  }
+
+  lotRows.clear();
+  lotFrontages.clear();
+  roadLots.assign(roads.size(), std::vector<unsigned int>());
+  roadBorderLots.assign(roads.size(), std::vector<BorderLot>());
+  for (const Lot& lot : lots) {
+    addLot(lot);
+  }
+}
+
+void FrontageIndex::addLot(const Lot& lot) {
+  // Row of tiles just outside of the street-facing side
+  const glm::ivec2 lotFrom = lot.position.getGlobal();
+  const glm::ivec2 lotTo = lotFrom + lot.size - glm::ivec2(1, 1);
+  glm::ivec2 from = lotFrom, to = lotTo;
+  switch (lot.direction) {
+  case Direction::N:
+    from.y = to.y = lotTo.y + 1;
+    break;
+  case Direction::S:
+    from.y = to.y = lotFrom.y - 1;
+    break;
+  case Direction::W:
+    from.x = to.x = lotTo.x + 1;
+    break;
+  case Direction::E:
+    from.x = to.x = lotFrom.x - 1;
+    break;
+  }
+
+  const unsigned int lotIndex = lotFrontages.size();
+  lotRows.push_back(std::make_pair(from, to));
+  lotFrontages.push_back(resolve(from, to, scratchRoads, tilesPerRoad));
+  for (unsigned int road : scratchRoads) {
+    roadLots[road].push_back(lotIndex);
+  }
+}
+
+void FrontageIndex::stitch(const std::vector<const Chunk*>& neighbours) {
+  for (unsigned int i = 0; i < lotRows.size(); i++) {
+    if (contains(lotRows[i].first)) {
+      continue;
+    }
+    lotFrontages[i] = Frontage();
+    for (const Chunk* neighbour : neighbours) {
+      const FrontageIndex& index = neighbour->getFrontageIndex();
+      if (index.contains(lotRows[i].first)) {
+        lotFrontages[i] = index.resolve(lotRows[i].first, lotRows[i].second, scratchRoads, tilesPerRoad);
+      }
+    }
+  }
+
+  roadBorderLots.assign(roadLots.size(), std::vector<BorderLot>());
+  for (const Chunk* neighbour : neighbours) {
+    const FrontageIndex& index = neighbour->getFrontageIndex();
+    for (unsigned int i = 0; i < index.lotRows.size(); i++) {
+      if (!contains(index.lotRows[i].first)) {
+        continue;
+      }
+      resolve(index.lotRows[i].first, index.lotRows[i].second, scratchRoads, tilesPerRoad);
+      for (unsigned int road : scratchRoads) {
+        roadBorderLots[road].push_back(BorderLot{neighbour, i});
+      }
+    }
+  }
+}
+
+const FrontageIndex::Frontage& FrontageIndex::getFrontage(unsigned int lotIndex) const {
+  return lotFrontages.at(lotIndex);
+}
+
+const std::vector<unsigned int>& FrontageIndex::getFrontingLots(const Road& road) const {
+  return roadLots.at(&road - graph->getRoads().data());
+}
+
+const std::vector<FrontageIndex::BorderLot>& FrontageIndex::getFrontingBorderLots(const Road& road) const {
+  return roadBorderLots.at(&road - graph->getRoads().data());
+}
+
+void FrontageIndex::paint(std::vector<int>& grid, glm::ivec2 from, glm::ivec2 to, int value) {
+  for (int x = from.x; x <= to.x; x++) {
+    for (int y = from.y; y <= to.y; y++) {
+      const glm::ivec2 local = glm::ivec2(x, y) - origin;
+      if (0 <= local.x && local.x < (int)Chunk::SIDE_LENGTH && 0 <= local.y && local.y < (int)Chunk::SIDE_LENGTH) {
+        grid[local.y * Chunk::SIDE_LENGTH + local.x] = value;
+      }
+    }
+  }
+}
+
+int FrontageIndex::getAt(const std::vector<int>& grid, glm::ivec2 global) const {
+  if (!contains(global)) {
+    return -1;
+  }
+  const glm::ivec2 local = global - origin;
+  return grid[local.y * Chunk::SIDE_LENGTH + local.x];
+}
+
+bool FrontageIndex::contains(glm::ivec2 global) const {
+  const glm::ivec2 local = global - origin;
+  return 0 <= local.x && local.x < (int)Chunk::SIDE_LENGTH && 0 <= local.y && local.y < (int)Chunk::SIDE_LENGTH;
+}
+
+FrontageIndex::Frontage FrontageIndex::resolve(glm::ivec2 from, glm::ivec2 to, std::vector<unsigned int>& roads,
+                                               std::vector<unsigned int>& tilesPerRoad) const {
+  // Segment fronting the most tiles gives access, node only when lot faces nothing else
+  Frontage frontage;
+  if (tilesPerRoad.size() < roadLots.size()) {
+    tilesPerRoad.resize(roadLots.size(), 0);
+  }
+  int bestRoad = -1;
+  roads.clear();
+  for (int x = from.x; x <= to.x; x++) {
+    for (int y = from.y; y <= to.y; y++) {
+      const int node = getAt(nodeAt, glm::ivec2(x, y));
+      const int road = getAt(roadAt, glm::ivec2(x, y));
+      if (node >= 0) {
+        if (frontage.node == nullptr) {
+          frontage.node = &graph->getNodes()[node];
+        }
+        continue;
+      }
+      if (road < 0) {
+        continue;
+      }
+      if (tilesPerRoad[road]++ == 0) {
+        roads.push_back(road);
+      }
+      if (bestRoad < 0 || tilesPerRoad[bestRoad] < tilesPerRoad[road]) {
+        bestRoad = road;
+      }
+    }
+  }
+
+  if (bestRoad >= 0) {
+    frontage.road = &graph->getRoads()[bestRoad];
+    frontage.node = nullptr;
+  }
+  for (unsigned int road : roads) {
+    tilesPerRoad[road] = 0;
+  }
+  return frontage;
+}
+}
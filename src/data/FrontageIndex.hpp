@@ -0,0 +1,81 @@
+#ifndef DATA_FRONTAGEINDEX_HPP
+#define DATA_FRONTAGEINDEX_HPP
+
+#include <glm/glm.hpp>
+#include <utility>
+#include <vector>
+
+#include "Lot.hpp"
+#include "Road.hpp"
+#include "RoadGraph.hpp"
+
+namespace data {
+
+class Chunk;
+
+/**
+ * Links lots of a chunk with road segments and nodes along their street-facing side, and road segments with lots
+ * fronting them. Lots are identified by their index in chunk, roads by their index in the road graph. Lots facing
+ * roads across chunk border are resolved by stitch().
+ */
+class FrontageIndex {
+
+public:
+  class Frontage {
+  public:
+    // Pointers are valid until the next modification of the road graph, or graph of the neighbour lot is facing.
+    const Road* road = nullptr;
+    const RoadGraph::Node* node = nullptr;
+
+    bool hasAccess() const {
+      return road != nullptr || node != nullptr;
+    }
+  };
+
+  class BorderLot {
+  public:
+    const Chunk* chunk;
+    unsigned int lotIndex;
+  };
+
+  void rebuild(const RoadGraph& graph, const std::vector<Lot>& lots, glm::ivec2 chunkPosition);
+  void addLot(const Lot& lot);
+  // Links lots and roads facing each other across chunk border, replacing previous links. Neighbours have to be
+  // rebuilt first, like in RoadGraph::stitch().
+  void stitch(const std::vector<const Chunk*>& neighbours);
+
+  const Frontage& getFrontage(unsigned int lotIndex) const;
+  // Lots of this chunk only
+  const std::vector<unsigned int>& getFrontingLots(const Road& road) const;
+  // Lots of neighbouring chunks, valid until the next stitch()
+  const std::vector<BorderLot>& getFrontingBorderLots(const Road& road) const;
+
+private:
+  const RoadGraph* graph = nullptr;
+  glm::ivec2 origin;
+
+  // Index of road segment and node covering each tile of the chunk, -1 if none
+  std::vector<int> roadAt;
+  std::vector<int> nodeAt;
+
+  // Row of tiles just outside of the street-facing side of each lot, inclusive
+  std::vector<std::pair<glm::ivec2, glm::ivec2>> lotRows;
+  std::vector<Frontage> lotFrontages;
+  std::vector<std::vector<unsigned int>> roadLots;
+  std::vector<std::vector<BorderLot>> roadBorderLots;
+
+  // Scratch of addLot() and stitch(), counters are zero between calls of resolve()
+  std::vector<unsigned int> scratchRoads;
+  std::vector<unsigned int> tilesPerRoad;
+
+  void paint(std::vector<int>& grid, glm::ivec2 from, glm::ivec2 to, int value);
+  int getAt(const std::vector<int>& grid, glm::ivec2 global) const;
+  bool contains(glm::ivec2 global) const;
+  // Access from given row of tiles of this chunk, fills roads covering the row. Counters come from the calling index,
+  // so resolving against a neighbour does not touch its state.
+  Frontage resolve(glm::ivec2 from, glm::ivec2 to, std::vector<unsigned int>& roads,
+                   std::vector<unsigned int>& tilesPerRoad) const;
+};
+}
+
+#endif
@@ -0,0 +1,132 @@
+#include "RectArray.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace data {
+
+namespace {
+constexpr unsigned int BLOCK = 8;
+
+// Query rectangle broadcast to all lanes once, bits of full block are then computed without branches
+#if defined(__AVX2__)
+struct Query {
+  __m256i fromX, fromY, toX, toY;
+
+  Query(glm::ivec2 from, glm::ivec2 to)
+      : fromX(_mm256_set1_epi32(from.x)), fromY(_mm256_set1_epi32(from.y)), toX(_mm256_set1_epi32(to.x)),
+        toY(_mm256_set1_epi32(to.y)) {}
+
+  uint32_t test(const int32_t* minX, const int32_t* minY, const int32_t* maxX, const int32_t* maxY) const {
+    const __m256i left = _mm256_cmpgt_epi32(fromX, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maxX)));
+    const __m256i right = _mm256_cmpgt_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(minX)), toX);
+    const __m256i below = _mm256_cmpgt_epi32(fromY, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(maxY)));
+    const __m256i above = _mm256_cmpgt_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(minY)), toY);
+    const __m256i miss = _mm256_or_si256(_mm256_or_si256(left, right), _mm256_or_si256(below, above));
+    return ~_mm256_movemask_ps(_mm256_castsi256_ps(miss)) & 0xFF;
+  }
+};
+#elif defined(__SSE2__)
+struct Query {
+  __m128i fromX, fromY, toX, toY;
+
+  Query(glm::ivec2 from, glm::ivec2 to)
+      : fromX(_mm_set1_epi32(from.x)), fromY(_mm_set1_epi32(from.y)), toX(_mm_set1_epi32(to.x)),
+        toY(_mm_set1_epi32(to.y)) {}
+
+  uint32_t test4(const int32_t* minX, const int32_t* minY, const int32_t* maxX, const int32_t* maxY) const {
+    const __m128i left = _mm_cmplt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(maxX)), fromX);
+    const __m128i right = _mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(minX)), toX);
+    const __m128i below = _mm_cmplt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(maxY)), fromY);
+    const __m128i above = _mm_cmpgt_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(minY)), toY);
+    const __m128i miss = _mm_or_si128(_mm_or_si128(left, right), _mm_or_si128(below, above));
+    return ~_mm_movemask_ps(_mm_castsi128_ps(miss)) & 0xF;
+  }
+
+  uint32_t test(const int32_t* minX, const int32_t* minY, const int32_t* maxX, const int32_t* maxY) const {
+    return test4(minX, minY, maxX, maxY) | test4(minX + 4, minY + 4, maxX + 4, maxY + 4) << 4;
+  }
+};
+#else
+struct Query {
+  glm::ivec2 from, to;
+
+  Query(glm::ivec2 from, glm::ivec2 to) : from(from), to(to) {}
+
+  uint32_t test(const int32_t* minX, const int32_t* minY, const int32_t* maxX, const int32_t* maxY) const {
+    uint32_t bits = 0;
+    for (unsigned int i = 0; i < BLOCK; i++) {
+      bits |= (uint32_t)intersects(glm::ivec2(minX[i], minY[i]), glm::ivec2(maxX[i], maxY[i]), from, to) << i;
+    }
+    return bits;
+  }
+};
+#endif
+}
+
+void RectArray::add(glm::ivec2 from, glm::ivec2 to) {
+  minX.push_back(from.x);
+  minY.push_back(from.y);
+  maxX.push_back(to.x);
+  maxY.push_back(to.y);
+}
+
+void RectArray::clear() {
+  minX.clear();
+  minY.clear();
+  maxX.clear();
+  maxY.clear();
+}
+
+unsigned int RectArray::size() const {
+  return minX.size();
+}
+
+int RectArray::findFirst(glm::ivec2 from, glm::ivec2 to, unsigned int start) const {
+  const Query query(from, to);
+  unsigned int first = start;
+  for (; first + BLOCK <= size(); first += BLOCK) {
+    const uint32_t bits = query.test(&minX[first], &minY[first], &maxX[first], &maxY[first]);
+    if (bits != 0) {
+      return first + countTrailingZeros(bits);
+    }
+  }
+  const uint32_t bits = testTail(first, from, to);
+  return (bits != 0) ? first + countTrailingZeros(bits) : -1;
+}
+
+void RectArray::getHitMask(glm::ivec2 from, glm::ivec2 to, std::vector<uint64_t>& mask) const {
+  const Query query(from, to);
+  mask.resize((size() + 63) / 64);
+  unsigned int first = 0;
+  for (uint64_t& word : mask) {
+    word = 0;
+    for (unsigned int shift = 0; shift < 64 && first + BLOCK <= size(); shift += BLOCK, first += BLOCK) {
+      word |= (uint64_t)query.test(&minX[first], &minY[first], &maxX[first], &maxY[first]) << shift;
+    }
+  }
+  if (first < size()) {
+    mask.back() |= (uint64_t)testTail(first, from, to) << (first % 64);
+  }
+}
+
+uint32_t RectArray::testTail(unsigned int first, glm::ivec2 from, glm::ivec2 to) const {
+  uint32_t bits = 0;
+  for (unsigned int i = first; i < size(); i++) {
+    bits |= (uint32_t)intersects(glm::ivec2(minX[i], minY[i]), glm::ivec2(maxX[i], maxY[i]), from, to) << (i - first);
+  }
+  return bits;
+}
+
+unsigned int RectArray::countTrailingZeros(uint32_t bits) {
+  unsigned int count = 0;
+  while ((bits & 1) == 0) {
+    bits >>= 1;
+    count++;
+  }
+  return count;
+}
+}
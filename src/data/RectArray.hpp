@@ -0,0 +1,44 @@
+#ifndef DATA_RECTARRAY_HPP
+#define DATA_RECTARRAY_HPP
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace data {
+
+/**
+ * Inclusive integer rectangles packed as structure of arrays, so they can be tested against single rectangle few at
+ * a time. Uses AVX2 or SSE2 when compiled in, plain loop otherwise.
+ */
+class RectArray {
+
+public:
+  void add(glm::ivec2 from, glm::ivec2 to);
+  void clear();
+  unsigned int size() const;
+
+  /**
+   * @return index of first rectangle not before `start` intersecting given one, -1 if there is none
+   */
+  int findFirst(glm::ivec2 from, glm::ivec2 to, unsigned int start = 0) const;
+
+  /**
+   * Sets bit i of mask (word i / 64) for every rectangle i intersecting given one.
+   */
+  void getHitMask(glm::ivec2 from, glm::ivec2 to, std::vector<uint64_t>& mask) const;
+
+private:
+  std::vector<int32_t> minX, minY, maxX, maxY;
+
+  // Bits of rectangles from `first` to the end, which has to be less than one block away
+  uint32_t testTail(unsigned int first, glm::ivec2 from, glm::ivec2 to) const;
+  static unsigned int countTrailingZeros(uint32_t bits);
+};
+
+inline bool intersects(glm::ivec2 aFrom, glm::ivec2 aTo, glm::ivec2 bFrom, glm::ivec2 bTo) {
+  return !(aTo.x < bFrom.x || bTo.x < aFrom.x || aTo.y < bFrom.y || bTo.y < aFrom.y);
+}
+}
+
+#endif
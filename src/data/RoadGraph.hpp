@@ -1,6 +1,7 @@
 #ifndef DATA_ROADGRAPH_HPP
 #define DATA_ROADGRAPH_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 #include <utility>
@@ -8,18 +9,30 @@
 
 #include "Direction.hpp"
 #include "Position.hpp"
+#include "RectArray.hpp"
 #include "Road.hpp"
 
 namespace data {
 
+/**
+ * Road network of a single chunk. Roads are stored as segments running between two nodes: either intersections
+ * (width x width squares where perpendicular roads cross) or dead ends (single row at the end of a road). A segment
+ * covers the tiles of both of its end nodes.
+ *
+ * Expects roads which passed Geometry::checkCollisions(), i.e. perpendicular roads overlap only on full squares and
+ * parallel roads overlap only when collinear.
+ */
 class RoadGraph {
 
 public:
   class Node {
   public:
     // TODO(kantoniak): Switch to C++17 and use <optional>
+    // Pointers are valid until the next modification of the graph.
     Road *N = nullptr, *S = nullptr, *W = nullptr, *E = nullptr;
     bool hasN = false, hasS = false, hasW = false, hasE = false;
+    // Nodes of neighbouring chunks continuing roads cut by chunk border. Valid until either graph changes.
+    const Node *nextN = nullptr, *nextS = nullptr, *nextW = nullptr, *nextE = nullptr;
     Position position;
     glm::ivec2 size;
 
@@ -36,15 +49,15 @@ public:
     }
   };
 
-  void test();
-
   void addRoad(const Road& road);
-  Node& addStartNode(Road& road);
-  Node& addEndNode(Road& road);
-  void pinRoadToNodeAndIterate(Road& road, Node& node);
-  bool posIsNotRoadEnd(const glm::ivec2 pos, const Road& road) const;
-  void iterateNewRoad(Road& road, glm::ivec2 startPoint);
+  // Same result as adding roads one by one, but nodes are rebuilt only once
+  void addRoads(const std::vector<Road>& roads);
   const std::vector<Road>& getRoads() const;
+  // Bounds of roads in the same order, for batch collision tests
+  const RectArray& getRoadBounds() const;
+
+  // Links border nodes with nodes of neighbouring graphs, replacing previous links
+  void stitch(const std::vector<const RoadGraph*>& neighbours);
 
   const std::vector<Node>& getNodes() const;
 
@@ -53,25 +66,34 @@ public:
 private:
   std::vector<Road> roads;
   std::vector<Node> nodes;
+  RectArray roadBounds;
+  RectArray nodeBounds;
 
-  bool hasRoadAt(const glm::ivec2 global) const;
-  bool hasRoadAt(const glm::ivec2 global, const Road& toIgnore) const;
-  Road& getRoadAt(const glm::ivec2 global);
-  Road& getRoadAt(const glm::ivec2 global, const Road& toIgnore);
+  void mergeCollinearRoads(Road& lane);
+  std::vector<int> splitCrossingRoads(const Road& lane);
+  void splitRoadAt(size_t index, const glm::ivec2 square);
+  void addLaneSegments(const Road& lane, const std::vector<int>& crossings);
+  void addSegment(const Road& lane, int from, int to);
+  void insertRoad(const Road& road);
+
+  void rebuildNodes();
+  void addNode(const glm::ivec2 square, const glm::ivec2 deadEnd, const Road& road);
+  bool hasCrossingAt(const glm::ivec2 square, const Road& road) const;
+  void linkNodes();
 
   // TODO(kantoniak): I need <optional> so bad...
   bool hasNodeAt(const glm::ivec2 global) const;
   Node& getNodeAt(const glm::ivec2 global);
-  std::vector<Node> getNodesCopy(std::vector<Road>& roadsCopy) const;
-
-  Node& divideRoadAt(const glm::ivec2 global, const Road& toIgnore);
+  const Node* findNodeAt(const glm::ivec2 global) const;
+  static const Node* findContinuation(const std::vector<const RoadGraph*>& neighbours, const glm::ivec2 global,
+                                      bool Node::*link);
 
-  void deleteNode(std::vector<Node>& nodes, Node& a);
+  int along(const glm::ivec2 global, Direction direction) const;
+  int across(const glm::ivec2 global, Direction direction) const;
+  glm::ivec2 onLane(const Road& lane, int along) const;
 
-  // FIXME(kantoniak): Copied from Geometry, fix this
-  template <typename T>
-  bool checkRectIntersection(glm::tvec2<T> a1, glm::tvec2<T> a2, glm::tvec2<T> b1, glm::tvec2<T> b2) const;
   bool checkIntersection(const data::Road& a, const data::Road& b) const;
+  bool isCollinear(const data::Road& a, const data::Road& b) const;
 };
 }
 
@@ -0,0 +1,60 @@
+#ifndef DATA_SUMMEDAREATABLE_HPP
+#define DATA_SUMMEDAREATABLE_HPP
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace data {
+
+/**
+ * Prefix sums of a 2D grid, so sum over any rectangle takes 4 lookups.
+ */
+template <typename T> class SummedAreaTable {
+
+public:
+  void reset(glm::ivec2 size) {
+    this->size = size;
+    sums.assign((size.x + 1) * (size.y + 1), 0);
+  }
+
+  glm::ivec2 getSize() const {
+    return size;
+  }
+
+  // Adds grid of given size, stored row by row. Sums are linear, so this works for both new values and deltas.
+  void add(const std::vector<T>& values) {
+    const int stride = size.x + 1;
+    std::vector<T> row(stride, 0);
+    for (int y = 0; y < size.y; y++) {
+      T rowSum = 0;
+      for (int x = 0; x < size.x; x++) {
+        rowSum += values[y * size.x + x];
+        row[x + 1] += rowSum;
+        sums[(y + 1) * stride + x + 1] += row[x + 1];
+      }
+    }
+  }
+
+  // Inclusive rectangle in grid coordinates, clamped to the grid
+  T getSum(glm::ivec2 from, glm::ivec2 to) const {
+    from = glm::max(from, glm::ivec2(0, 0));
+    to = glm::min(to, size - glm::ivec2(1, 1));
+    if (to.x < from.x || to.y < from.y) {
+      return 0;
+    }
+    return getPrefix(to + glm::ivec2(1, 1)) - getPrefix(glm::ivec2(from.x, to.y + 1)) -
+           getPrefix(glm::ivec2(to.x + 1, from.y)) + getPrefix(from);
+  }
+
+private:
+  glm::ivec2 size = glm::ivec2(0, 0);
+  // One row and column of zeros in front, so lookups need no bounds checks
+  std::vector<T> sums;
+
+  T getPrefix(glm::ivec2 end) const {
+    return sums[end.y * (size.x + 1) + end.x];
+  }
+};
+}
+
+#endif
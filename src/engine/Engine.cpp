@@ -2,6 +2,8 @@
 
 #include <cassert>
 
+#include "../settings.hpp"
+
 namespace engine {
 
 Engine::Engine(settings& gameSettings, Logger& logger)
@@ -21,7 +23,8 @@ void Engine::stop() {
 }
 
 bool Engine::init(input::WindowHandler& windowHandler, rendering::Renderer& renderer, rendering::UI& ui) {
-  srand(time(nullptr));
+  random.setSeed(gameSettings.world.hasSeed ? gameSettings.world.seed : time(nullptr));
+  logger.info("Random seed: %u", random.getSeed());
 
   this->start = std::chrono::high_resolution_clock::now();
   this->current = this->start;
@@ -112,6 +115,10 @@ DebugInfo& Engine::getDebugInfo() {
   return debugInfo;
 }
 
+Random& Engine::getRandom() {
+  return random;
+}
+
 input::WindowHandler& Engine::getWindowHandler() const {
   assert(windowHandler != nullptr);
   return *windowHandler;
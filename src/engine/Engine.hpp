@@ -10,6 +10,7 @@
 #include "DebugInfo.hpp"
 #include "GameState.hpp"
 #include "Logger.hpp"
+#include "Random.hpp"
 
 struct settings;
 
@@ -49,6 +50,7 @@ public:
   settings& getSettings() const;
   Logger& getLogger() const;
   DebugInfo& getDebugInfo();
+  Random& getRandom();
   input::WindowHandler& getWindowHandler() const;
   rendering::Renderer& getRenderer() const;
   rendering::UI& getUI() const;
@@ -59,6 +61,7 @@ protected:
 
   Logger& logger;
   DebugInfo debugInfo;
+  Random random;
   input::WindowHandler* windowHandler;
   rendering::Renderer* renderer;
   rendering::UI* ui;
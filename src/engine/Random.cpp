@@ -0,0 +1,77 @@
+#include "Random.hpp"
+
+namespace engine {
+
+namespace {
+constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+constexpr uint32_t WEYL_0 = 0x9E3779B9;
+constexpr uint32_t WEYL_1 = 0xBB67AE85;
+constexpr unsigned int ROUNDS = 10;
+}
+
+Random::Stream::result_type Random::Stream::operator()() {
+  if (used == block.size()) {
+    block = philox(counter, key);
+    counter[0]++;
+    used = 0;
+  }
+  return block[used++];
+}
+
+uint32_t Random::Stream::nextBelow(uint32_t bound) {
+  // Multiply and shift, rejecting the few values which would make lower results more likely
+  const uint32_t threshold = (0u - bound) % bound;
+  while (true) {
+    const uint64_t product = (uint64_t)(*this)() * bound;
+    if ((uint32_t)product >= threshold) {
+      return product >> 32;
+    }
+  }
+}
+
+float Random::Stream::nextFloat() {
+  return ((*this)() >> 8) * (1.f / (1u << 24));
+}
+
+void Random::Stream::discard(uint64_t count) {
+  // Numbers left in current block go first
+  const uint64_t position = (uint64_t)counter[0] * block.size() - (block.size() - used) + count;
+  counter[0] = position / block.size();
+  used = block.size();
+  const unsigned int offset = position % block.size();
+  if (offset != 0) {
+    (*this)();
+    used = offset;
+  }
+}
+
+Random::Stream::Stream(Key key, Counter counter) : key(key), counter(counter), used(std::tuple_size<Counter>::value) {}
+
+Random::Random(uint32_t seed) : seed(seed) {}
+
+void Random::setSeed(uint32_t seed) {
+  this->seed = seed;
+}
+
+uint32_t Random::getSeed() const {
+  return seed;
+}
+
+Random::Stream Random::getStream(RandomSystem system, glm::ivec2 chunk, uint32_t turn) const {
+  // Index of number in stream takes the first word of counter
+  return Stream(Key{{seed, (uint32_t)system}}, Counter{{0, turn, (uint32_t)chunk.x, (uint32_t)chunk.y}});
+}
+
+Random::Counter Random::philox(Counter counter, Key key) {
+  for (unsigned int round = 0; round < ROUNDS; round++) {
+    const uint64_t product0 = (uint64_t)MULTIPLIER_0 * counter[0];
+    const uint64_t product1 = (uint64_t)MULTIPLIER_1 * counter[2];
+    counter = Counter{{(uint32_t)(product1 >> 32) ^ counter[1] ^ key[0], (uint32_t)product1,
+                       (uint32_t)(product0 >> 32) ^ counter[3] ^ key[1], (uint32_t)product0}};
+    key[0] += WEYL_0;
+    key[1] += WEYL_1;
+  }
+  return counter;
+}
+}
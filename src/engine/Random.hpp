@@ -0,0 +1,72 @@
+#ifndef ENGINE_RANDOM_HPP
+#define ENGINE_RANDOM_HPP
+
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <limits>
+
+namespace engine {
+
+// Parts of the game drawing their own random numbers, so they never share a stream
+enum class RandomSystem : uint32_t { WORLD_GENERATOR = 1, SIMULATION = 2, SCENARIO = 3 };
+
+/**
+ * Counter-based random numbers (Philox4x32-10). Every number is a pure function of seed, system, turn, chunk and its
+ * index in the stream, so streams can be created and used on any thread, in any order, and replay the same way.
+ */
+class Random {
+
+public:
+  typedef std::array<uint32_t, 4> Counter;
+  typedef std::array<uint32_t, 2> Key;
+
+  /**
+   * Satisfies UniformRandomBitGenerator, so it works with <random> distributions.
+   */
+  class Stream {
+  public:
+    typedef uint32_t result_type;
+
+    static constexpr result_type min() {
+      return 0;
+    }
+
+    static constexpr result_type max() {
+      return std::numeric_limits<result_type>::max();
+    }
+
+    result_type operator()();
+    // Uniform in [0, bound), bound has to be positive
+    uint32_t nextBelow(uint32_t bound);
+    // Uniform in [0, 1)
+    float nextFloat();
+    // Skips given amount of numbers without generating them
+    void discard(uint64_t count);
+
+  private:
+    friend class Random;
+
+    Stream(Key key, Counter counter);
+
+    Key key;
+    Counter counter;
+    Counter block;
+    unsigned int used;
+  };
+
+  Random(uint32_t seed = 0);
+
+  void setSeed(uint32_t seed);
+  uint32_t getSeed() const;
+
+  Stream getStream(RandomSystem system, glm::ivec2 chunk = glm::ivec2(), uint32_t turn = 0) const;
+
+  static Counter philox(Counter counter, Key key);
+
+private:
+  uint32_t seed;
+};
+}
+
+#endif
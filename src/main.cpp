@@ -7,6 +7,7 @@
 #include "settings.hpp"
 #include "states/MainMenuState.hpp"
 #include "states/MapState.hpp"
+#include "world/ScenarioGenerator.hpp"
 
 // Returns value after prefix if prefix exists, else null
 char* stripPrefix(const char* prefix, char* str) {
@@ -19,6 +20,7 @@ char* stripPrefix(const char* prefix, char* str) {
 
 void initSettings(engine::Logger& logger, settings& gameSettings, int argc, char** argv) {
 
+  world::settings::Scenario& scenario = gameSettings.world.scenario;
   for (int i = 1; i < argc; i++) {
     // Width
     char* width = stripPrefix("--width=", argv[i]);
@@ -41,6 +43,65 @@ void initSettings(engine::Logger& logger, settings& gameSettings, int argc, char
       continue;
     }
 
+    // Seed
+    char* seed = stripPrefix("--seed=", argv[i]);
+    if (nullptr != seed) {
+      gameSettings.world.hasSeed = true;
+      gameSettings.world.seed = strtoul(seed, nullptr, 10);
+      continue;
+    }
+
+    // Stress scenario, preset first, then flags below can change it
+    char* scenarioPreset = stripPrefix("--scenario=", argv[i]);
+    if (nullptr != scenarioPreset) {
+      if (!world::ScenarioGenerator::getPreset(scenarioPreset, scenario)) {
+        logger.warn("Unknown scenario: %s", scenarioPreset);
+      }
+      continue;
+    }
+
+    char* scenarioSize = stripPrefix("--scenarioSize=", argv[i]);
+    if (nullptr != scenarioSize) {
+      if (sscanf(scenarioSize, "%ux%u", &scenario.width, &scenario.height) != 2) {
+        logger.warn("Scenario size has to be WIDTHxHEIGHT in chunks: %s", scenarioSize);
+      }
+      continue;
+    }
+
+    char* roadSpacing = stripPrefix("--roadSpacing=", argv[i]);
+    if (nullptr != roadSpacing) {
+      scenario.roadSpacing = atoi(roadSpacing);
+      continue;
+    }
+
+    char* lotDensity = stripPrefix("--lotDensity=", argv[i]);
+    if (nullptr != lotDensity) {
+      scenario.lotDensity = atof(lotDensity);
+      continue;
+    }
+
+    char* buildingsPerChunk = stripPrefix("--buildingsPerChunk=", argv[i]);
+    if (nullptr != buildingsPerChunk) {
+      scenario.buildingsPerChunk = atoi(buildingsPerChunk);
+      continue;
+    }
+
+    char* buildingHeight = stripPrefix("--buildingHeight=", argv[i]);
+    if (nullptr != buildingHeight) {
+      if (sscanf(buildingHeight, "%u-%u", &scenario.minBuildingHeight, &scenario.maxBuildingHeight) != 2) {
+        logger.warn("Building height has to be MIN-MAX: %s", buildingHeight);
+      }
+      continue;
+    }
+
+    char* heightDistribution = stripPrefix("--heightDistribution=", argv[i]);
+    if (nullptr != heightDistribution) {
+      if (!world::ScenarioGenerator::getHeightDistribution(heightDistribution, scenario.heightDistribution)) {
+        logger.warn("Unknown height distribution: %s", heightDistribution);
+      }
+      continue;
+    }
+
     // Logging
     char* loggingLevel = stripPrefix("--loggingLevel=", argv[i]);
     if (nullptr != loggingLevel) {
@@ -50,6 +111,11 @@ void initSettings(engine::Logger& logger, settings& gameSettings, int argc, char
 
     logger.warn("Unsupported flag: %s", argv[i]);
   }
+
+  if (!world::ScenarioGenerator::clampToLimits(scenario)) {
+    logger.warn("Scenario clamped to %ux%u chunks and building height %u-%u", scenario.width, scenario.height,
+                scenario.minBuildingHeight, scenario.maxBuildingHeight);
+  }
 }
 
 int main(int argc, char** argv) {
@@ -1,5 +1,9 @@
 #include "WorldRenderer.hpp"
 
+#include <cassert>
+#include <cstddef>
+#include <limits>
+
 #include "../data/Chunk.hpp"
 
 namespace rendering {
@@ -38,26 +42,27 @@ bool WorldRenderer::setupShaders() {
   selectionColorLoc = glGetUniformLocation(shaderProgram, "selectionColor");
   groundTextureLoc = glGetUniformLocation(shaderProgram, "groundTexture");
   roadTextureLoc = glGetUniformLocation(shaderProgram, "roadTexture");
+  tileTextureLoc = glGetUniformLocation(shaderProgram, "tileTexture");
 
   glDeleteShader(vertexShader);
   glDeleteShader(fragmentShader);
 
   GLuint buildingsVertexShader = compileShader(GL_VERTEX_SHADER, "assets/shaders/buildings.vs");
-  GLuint buildingsGeomShader = compileShader(GL_GEOMETRY_SHADER, "assets/shaders/buildings.gs");
   GLuint buildingsFragmentShader = compileShader(GL_FRAGMENT_SHADER, "assets/shaders/buildings.fs");
-  this->buildingsShaderProgram = ShaderManager::linkProgram(buildingsVertexShader, buildingsGeomShader,
-                                                            buildingsFragmentShader, engine.getLogger());
+  this->buildingsShaderProgram =
+      ShaderManager::linkProgram(buildingsVertexShader, 0, buildingsFragmentShader, engine.getLogger());
   buildingsTransformLoc = glGetUniformLocation(buildingsShaderProgram, "transform");
 
+  GLuint buildingNormalsVertexShader = compileShader(GL_VERTEX_SHADER, "assets/shaders/buildings_normals.vs");
   GLuint buildingNormalsGeomShader = compileShader(GL_GEOMETRY_SHADER, "assets/shaders/buildings_normals.gs");
   GLuint buildingsNormalFragmentShader = compileShader(GL_FRAGMENT_SHADER, "assets/shaders/buildings_normals.fs");
-  this->buildingNormalsShaderProgram = ShaderManager::linkProgram(buildingsVertexShader, buildingNormalsGeomShader,
-                                                                  buildingsNormalFragmentShader, engine.getLogger());
+  this->buildingNormalsShaderProgram = ShaderManager::linkProgram(
+      buildingNormalsVertexShader, buildingNormalsGeomShader, buildingsNormalFragmentShader, engine.getLogger());
   buildingNormalsTransformLoc = glGetUniformLocation(buildingNormalsShaderProgram, "transform");
 
   glDeleteShader(buildingsVertexShader);
-  glDeleteShader(buildingsGeomShader);
-  glDeleteShader(buildingsVertexShader);
+  glDeleteShader(buildingsFragmentShader);
+  glDeleteShader(buildingNormalsVertexShader);
   glDeleteShader(buildingNormalsGeomShader);
   glDeleteShader(buildingsNormalFragmentShader);
 
@@ -104,16 +109,54 @@ bool WorldRenderer::setupTextures() {
 
 bool WorldRenderer::setupTerrain() {
   glGenVertexArrays(1, &VAO);
+  glBindVertexArray(VAO);
+
+  // Quad of one chunk in local coordinates, shared by all chunks. Tiles are looked up per fragment.
+  std::vector<glm::vec3> positions{glm::vec3(1, 0, 0), glm::vec3(0, 0, 0), glm::vec3(1, 0, 1),
+                                   glm::vec3(1, 0, 1), glm::vec3(0, 0, 0), glm::vec3(0, 0, 1)};
+  for (glm::vec3& position : positions) {
+    position *= (float)data::Chunk::SIDE_LENGTH;
+  }
+
+  glGenBuffers(1, &terrainPositionVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, terrainPositionVBO);
+  glBufferDataVector(GL_ARRAY_BUFFER, positions, GL_STATIC_DRAW);
+  glEnableVertexAttribArray(0);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+
+  // Visible chunks as instances, pointer is set for each page when drawing
+  glGenBuffers(1, &terrainInstanceVBO);
+  glEnableVertexAttribArray(1);
+  glVertexAttribDivisor(1, 1);
+
+  // Tiles of chunks are layers of texture arrays, pages grow with chunks up to as many layers as driver allows
+  glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &terrainPageLayers);
+  terrainPageLayers = std::min(terrainPageLayers, 2048);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindVertexArray(0);
+
   markTileDataForUpdate();
   return true;
 }
 
 bool WorldRenderer::setupBuildings() {
-  GLfloat building[] = {// 8x2
-                        0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f,
-                        1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f,
-                        0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, // Reset
-                        1.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 1.0f, 0.0f, 1.0f, 1.0f};
+  // Unit box without bottom, position and normal of each vertex. Faces wind counter-clockwise seen from outside.
+  GLfloat building[] = {1.0f, 0.0f, 0.0f, 1.0f,  0.0f, 0.0f,  1.0f, 1.0f, 0.0f, 1.0f,  0.0f, 0.0f, // +x
+                        1.0f, 1.0f, 1.0f, 1.0f,  0.0f, 0.0f,  1.0f, 0.0f, 1.0f, 1.0f,  0.0f, 0.0f,
+                        0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f,  0.0f, 0.0f, 1.0f, -1.0f, 0.0f, 0.0f, // -x
+                        0.0f, 1.0f, 1.0f, -1.0f, 0.0f, 0.0f,  0.0f, 1.0f, 0.0f, -1.0f, 0.0f, 0.0f,
+                        0.0f, 1.0f, 0.0f, 0.0f,  1.0f, 0.0f,  0.0f, 1.0f, 1.0f, 0.0f,  1.0f, 0.0f, // +y
+                        1.0f, 1.0f, 1.0f, 0.0f,  1.0f, 0.0f,  1.0f, 1.0f, 0.0f, 0.0f,  1.0f, 0.0f,
+                        0.0f, 0.0f, 1.0f, 0.0f,  0.0f, 1.0f,  1.0f, 0.0f, 1.0f, 0.0f,  0.0f, 1.0f, // +z
+                        1.0f, 1.0f, 1.0f, 0.0f,  0.0f, 1.0f,  0.0f, 1.0f, 1.0f, 0.0f,  0.0f, 1.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f,  0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f,  0.0f, -1.0f, // -z
+                        1.0f, 1.0f, 0.0f, 0.0f,  0.0f, -1.0f, 1.0f, 0.0f, 0.0f, 0.0f,  0.0f, -1.0f};
+  std::vector<GLubyte> indices;
+  for (GLubyte face = 0; face < 5; face++) {
+    indices.insert(indices.end(), {GLubyte(4 * face), GLubyte(4 * face + 1), GLubyte(4 * face + 2),
+                                   GLubyte(4 * face), GLubyte(4 * face + 2), GLubyte(4 * face + 3)});
+  }
 
   glGenVertexArrays(1, &buildingsVAO);
   glBindVertexArray(buildingsVAO);
@@ -122,17 +165,25 @@ bool WorldRenderer::setupBuildings() {
   glBindBuffer(GL_ARRAY_BUFFER, buildingsVBO);
   glBufferData(GL_ARRAY_BUFFER, sizeof(building), building, GL_STATIC_DRAW);
   glEnableVertexAttribArray(0);
-  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(GLfloat), (GLvoid*)0);
+  glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
+  glEnableVertexAttribArray(3);
+  glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
+
+  glGenBuffers(1, &buildingsEBO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buildingsEBO);
+  glBufferDataVector(GL_ELEMENT_ARRAY_BUFFER, indices, GL_STATIC_DRAW);
+  buildingsIndexCount = indices.size();
 
   glGenBuffers(1, &buildingsInstanceVBO);
   glBindBuffer(GL_ARRAY_BUFFER, buildingsInstanceVBO);
 
   glEnableVertexAttribArray(1);
-  glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)0);
+  glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, sizeof(BuildingInstance), (GLvoid*)0);
   glVertexAttribDivisor(1, 1);
 
   glEnableVertexAttribArray(2);
-  glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
+  glVertexAttribPointer(2, 3, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(BuildingInstance),
+                        (GLvoid*)offsetof(BuildingInstance, width));
   glVertexAttribDivisor(2, 1);
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
@@ -151,12 +202,12 @@ void WorldRenderer::cleanup() {
   glDeleteBuffers(1, &terrainPositionVBO);
   glDeleteProgram(this->shaderProgram);
 
-  for (auto it = chunks.begin(); it != chunks.end(); it++) {
-    glDeleteBuffers(1, &(it->second));
-  }
+  glDeleteBuffers(1, &terrainInstanceVBO);
+  glDeleteTextures(terrainPages.size(), terrainPages.data());
 
   glDeleteVertexArrays(1, &buildingsVAO);
   glDeleteBuffers(1, &buildingsVBO);
+  glDeleteBuffers(1, &buildingsEBO);
   glDeleteBuffers(1, &buildingsInstanceVBO);
   glDeleteProgram(this->buildingsShaderProgram);
 
@@ -169,10 +220,27 @@ void WorldRenderer::markBuildingDataForUpdate() {
   resendBuildingData = true;
 }
 
+void WorldRenderer::markBuildingDataForUpdate(const std::vector<glm::ivec2>& changedChunks) {
+  for (const glm::ivec2& chunk : changedChunks) {
+    dirtyBuildingChunks.insert(std::make_pair(chunk.x, chunk.y));
+  }
+}
+
 void WorldRenderer::markTileDataForUpdate() {
   resendTileData = true;
 }
 
+void WorldRenderer::markTileDataForUpdate(const std::vector<glm::ivec2>& changedChunks) {
+  // Objects of a chunk are painted also on its neighbours in +x and +y, see sendTileData()
+  for (const glm::ivec2& chunk : changedChunks) {
+    for (int dx = 0; dx <= 1; dx++) {
+      for (int dy = 0; dy <= 1; dy++) {
+        dirtyChunks.insert(std::make_pair(chunk.x + dx, chunk.y + dy));
+      }
+    }
+  }
+}
+
 void WorldRenderer::renderWorld(const input::Selection& selection) {
 
   glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
@@ -185,7 +253,30 @@ void WorldRenderer::renderWorld(const input::Selection& selection) {
   if (resendTileData) {
     sendTileData();
     resendTileData = false;
+    dirtyChunks.clear();
+  } else if (!dirtyChunks.empty()) {
+    sendDirtyTileData();
+    dirtyChunks.clear();
+  }
+  // Building ranges have to match chunks before culling uses them, new buildings can also grow chunk bounds
+  bool boundsChanged = false;
+  if (resendBuildingData || buildingRanges.size() != world.getMap().getChunksCount()) {
+    sendBuildingData();
+    resendBuildingData = false;
+    dirtyBuildingChunks.clear();
+    boundsChanged = true;
+  } else if (!dirtyBuildingChunks.empty()) {
+    sendDirtyBuildingData();
+    dirtyBuildingChunks.clear();
+    boundsChanged = true;
   }
+  const unsigned long regionVersion = world.getVisibleRegion().getVersion();
+  if (boundsChanged || regionVersion != culledRegionVersion) {
+    cullChunks(vp);
+    sendTerrainInstances();
+    culledRegionVersion = regionVersion;
+  }
+  drawCount = 0;
 
   glUseProgram(shaderProgram);
   glBindVertexArray(VAO);
@@ -195,6 +286,7 @@ void WorldRenderer::renderWorld(const input::Selection& selection) {
   glBindTexture(GL_TEXTURE_2D_ARRAY, roadTexture);
   glUniform1i(groundTextureLoc, 0);
   glUniform1i(roadTextureLoc, 1);
+  glUniform1i(tileTextureLoc, 2);
 
   glUniformMatrix4fv(transformLoc, 1, GL_FALSE, glm::value_ptr(vp));
   glUniform1i(renderGridLoc, engine.getSettings().world.showGrid);
@@ -203,30 +295,27 @@ void WorldRenderer::renderWorld(const input::Selection& selection) {
   glUniform4f(selectionColorLoc, selection.getColor().x, selection.getColor().y, selection.getColor().z,
               engine.getSettings().rendering.renderSelection ? selection.getColor().w : 0);
 
-  glEnableVertexAttribArray(0);
-  glEnableVertexAttribArray(1);
-  for (data::Chunk* chunk : world.getMap().getChunks()) {
-    glBindBuffer(GL_ARRAY_BUFFER, chunks[std::make_pair(chunk->getPosition().x, chunk->getPosition().y)]);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid*)0);
-    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), (GLvoid*)(3 * sizeof(GLfloat)));
-
-    glDrawArrays(GL_TRIANGLES, 0, data::Chunk::SIDE_LENGTH * data::Chunk::SIDE_LENGTH * 2 * 3);
+  // One instanced draw per page of tile layers
+  glActiveTexture(GL_TEXTURE2);
+  glBindBuffer(GL_ARRAY_BUFFER, terrainInstanceVBO);
+  for (const TerrainDraw& draw : terrainDraws) {
+    glBindTexture(GL_TEXTURE_2D_ARRAY, terrainPages[draw.page]);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(TerrainInstance),
+                          (GLvoid*)(draw.first * sizeof(TerrainInstance)));
+    glDrawArraysInstanced(GL_TRIANGLES, 0, TERRAIN_VERTICES, draw.count);
+    drawCount++;
   }
-  glDisableVertexAttribArray(1);
-  glDisableVertexAttribArray(0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  glActiveTexture(GL_TEXTURE0);
 
   // Buildings
-  if (resendBuildingData) {
-    sendBuildingData();
-    resendBuildingData = false;
-  }
-
   if (world.getMap().getBuildingCount() > 0) {
     glUseProgram(buildingsShaderProgram);
     glBindVertexArray(buildingsVAO);
 
     glUniformMatrix4fv(buildingsTransformLoc, 1, GL_FALSE, glm::value_ptr(vp));
-    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 16, world.getMap().getBuildingCount());
+    drawVisibleBuildings();
   }
 
   glBindVertexArray(0);
@@ -240,14 +329,61 @@ void WorldRenderer::renderDebug() {
     glUseProgram(buildingNormalsShaderProgram);
     glBindVertexArray(buildingsVAO);
 
-    glUniformMatrix4fv(buildingsTransformLoc, 1, GL_FALSE, glm::value_ptr(vp));
-    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 16, world.getMap().getBuildingCount());
+    glUniformMatrix4fv(buildingNormalsTransformLoc, 1, GL_FALSE, glm::value_ptr(vp));
+    drawVisibleBuildings();
 
     glBindVertexArray(0);
     glFlush();
   }
 }
 
+void WorldRenderer::cullChunks(const glm::mat4& viewProjection) {
+  // Only chunks on the ground seen by the camera can pass, frustum test drops ones just off the screen
+  const world::VisibleRegion& region = world.getVisibleRegion();
+  visibleChunks.clear();
+  for (unsigned int index : world::cullChunks(region.getChunks(), world::Frustum(viewProjection))) {
+    visibleChunks.push_back(region.getChunkIndices()[index]);
+  }
+  visibleChunkCount = visibleChunks.size();
+}
+
+void WorldRenderer::drawVisibleBuildings() {
+  GLuint first = 0;
+  GLuint count = 0;
+  for (unsigned int index : visibleChunks) {
+    const BuildingRange& range = buildingRanges[index];
+    if (range.count == 0) {
+      continue;
+    }
+    // Slots in between are empty or belong to chunks out of view, drawing few of them is cheaper than another draw
+    constexpr GLuint maxDrawnGap = 32;
+    if (count > 0 && first + count <= range.first && range.first - (first + count) <= maxDrawnGap) {
+      count = range.first + range.count - first;
+      continue;
+    }
+    if (count > 0) {
+      drawBuildingInstances(first, count);
+    }
+    first = range.first;
+    count = range.count;
+  }
+  if (count > 0) {
+    drawBuildingInstances(first, count);
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void WorldRenderer::drawBuildingInstances(GLuint first, GLuint count) {
+  // No base instance in OpenGL 3.3, so instance attributes start at the range instead
+  const size_t offset = first * sizeof(BuildingInstance);
+  glBindBuffer(GL_ARRAY_BUFFER, buildingsInstanceVBO);
+  glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, sizeof(BuildingInstance), (GLvoid*)offset);
+  glVertexAttribPointer(2, 3, GL_UNSIGNED_BYTE, GL_FALSE, sizeof(BuildingInstance),
+                        (GLvoid*)(offset + offsetof(BuildingInstance, width)));
+  glDrawElementsInstanced(GL_TRIANGLES, buildingsIndexCount, GL_UNSIGNED_BYTE, (GLvoid*)0, count);
+  drawCount++;
+}
+
 void WorldRenderer::renderUI() {
   const glm::vec2 viewport = engine.getWindowHandler().getViewportSize();
   NVGcontext* context = engine.getUI().getContext();
@@ -377,9 +513,12 @@ void WorldRenderer::renderDebugUI() {
   const std::string render = "Render: " + std::to_string(engine.getDebugInfo().getRenderTime()) + " ms";
   const std::string renderWorld = "  World: " + std::to_string(engine.getDebugInfo().getRenderWorldTime()) + " ms";
   const std::string renderUI = "  UI: " + std::to_string(engine.getDebugInfo().getRenderUITime()) + " ms";
+  const std::string visible =
+      "Chunks: " + std::to_string(visibleChunkCount) + "/" + std::to_string(world.getMap().getChunksCount());
+  const std::string draws = "Draws: " + std::to_string(drawCount);
 
   nvgBeginPath(context);
-  nvgRect(context, margin, margin, 100, 2 * textMargin + 5 * lineHeight);
+  nvgRect(context, margin, margin, 140, 2 * textMargin + 7 * lineHeight);
   nvgFillColor(context, engine.getUI().getBackgroundColor());
   nvgFill(context);
 
@@ -393,6 +532,8 @@ void WorldRenderer::renderDebugUI() {
   nvgText(context, 1.8f * margin, margin + textMargin + lineHeight / 2.f + 3 * lineHeight, renderWorld.c_str(),
           nullptr);
   nvgText(context, 1.8f * margin, margin + textMargin + lineHeight / 2.f + 4 * lineHeight, renderUI.c_str(), nullptr);
+  nvgText(context, 1.8f * margin, margin + textMargin + lineHeight / 2.f + 5 * lineHeight, visible.c_str(), nullptr);
+  nvgText(context, 1.8f * margin, margin + textMargin + lineHeight / 2.f + 6 * lineHeight, draws.c_str(), nullptr);
 }
 
 void WorldRenderer::setLeftMenuActiveIcon(int index) {
@@ -400,61 +541,201 @@ void WorldRenderer::setLeftMenuActiveIcon(int index) {
 }
 
 void WorldRenderer::sendBuildingData() {
-  const unsigned int buildingCount = world.getMap().getBuildingCount();
-  if (buildingCount < 1) {
-    return;
+  const std::vector<data::Chunk*> mapChunks = world.getMap().getChunks();
+  buildingPages.clear();
+  buildingRanges.clear();
+
+  // Pages get room to grow, whole buffer gets room for pages moved out when they outgrow it
+  GLuint first = 0;
+  for (unsigned int i = 0; i < mapChunks.size(); i++) {
+    BuildingPage page;
+    page.chunkIndex = i;
+    page.first = first;
+    page.buildings = mapChunks[i]->getResidentials();
+    page.capacity = getPageCapacity(page.buildings.size());
+    buildingRanges.push_back(BuildingRange{first, (GLuint)page.buildings.size()});
+    first += page.capacity;
+    buildingPages[std::make_pair(mapChunks[i]->getPosition().x, mapChunks[i]->getPosition().y)] = page;
+  }
+  buildingSlotCount = first + first / 4;
+  freeBuildingSlotCount = buildingSlotCount - first;
+  freeBuildingSlots.clear();
+  if (freeBuildingSlotCount > 0) {
+    freeBuildingSlots.push_back(std::make_pair(first, freeBuildingSlotCount));
   }
 
-  std::vector<glm::vec3> buildingPositions;
-  buildingPositions.reserve(2 * buildingCount);
-
-  constexpr float buildingMargin = 0.2f;
-  for (data::Chunk* chunk : world.getMap().getChunks()) {
-    for (data::buildings::Building building : chunk->getResidentials()) {
-      buildingPositions.push_back(glm::vec3(building.x + buildingMargin, 0, building.y + buildingMargin));
-      buildingPositions.push_back(
-          glm::vec3(building.width - 2 * buildingMargin, building.level, building.length - 2 * buildingMargin));
+  if (buildingSlotCount == 0) {
+    return;
+  }
+  std::vector<BuildingInstance> instances(buildingSlotCount, BuildingInstance{0, 0, 0, 0, 0, 0});
+  for (const auto& entry : buildingPages) {
+    const BuildingPage& page = entry.second;
+    for (unsigned int i = 0; i < page.buildings.size(); i++) {
+      instances[page.first + i] = getBuildingInstance(page.buildings[i]);
     }
   }
-  glBindVertexArray(buildingsVAO);
   glBindBuffer(GL_ARRAY_BUFFER, buildingsInstanceVBO);
-  glBufferDataVector(GL_ARRAY_BUFFER, buildingPositions, GL_STATIC_DRAW);
+  glBufferDataVector(GL_ARRAY_BUFFER, instances, GL_DYNAMIC_DRAW);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
 }
 
-void WorldRenderer::sendTileData() {
-  glBindVertexArray(VAO);
+void WorldRenderer::sendDirtyBuildingData() {
+  glBindBuffer(GL_ARRAY_BUFFER, buildingsInstanceVBO);
+  bool fits = true;
+  for (const std::pair<int, int>& position : dirtyBuildingChunks) {
+    const glm::ivec2 chunkPosition = glm::ivec2(position.first, position.second);
+    if (world.getMap().chunkExists(chunkPosition)) {
+      fits = fits && sendChunkBuildings(world.getMap().getChunk(chunkPosition));
+    }
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-  constexpr unsigned long verticesCount = data::Chunk::SIDE_LENGTH * data::Chunk::SIDE_LENGTH * 2 * 3;
-  const std::vector<glm::vec3> fieldBase{glm::vec3(1, 0, 0), glm::vec3(0, 0, 0), glm::vec3(1, 0, 1),
-                                         glm::vec3(1, 0, 1), glm::vec3(0, 0, 0), glm::vec3(0, 0, 1)};
+  // Buffer is packed again when out of space or when moved pages left too much of it unused
+  if (!fits || freeBuildingSlotCount > buildingSlotCount / 2) {
+    sendBuildingData();
+  }
+}
 
-  // Generate buffers
-  std::vector<glm::vec3> positions;
-  positions.resize(verticesCount);
+bool WorldRenderer::sendChunkBuildings(const data::Chunk& chunk) {
+  auto found = buildingPages.find(std::make_pair(chunk.getPosition().x, chunk.getPosition().y));
+  if (found == buildingPages.end()) {
+    return false;
+  }
+  BuildingPage& page = found->second;
+  const std::vector<data::buildings::Building> buildings = chunk.getResidentials();
+
+  if (buildings.size() > page.capacity) {
+    GLuint first;
+    const GLuint capacity = getPageCapacity(buildings.size());
+    if (!allocateBuildingSlots(capacity, first)) {
+      return false;
+    }
+    clearBuildingInstances(page.first, page.buildings.size());
+    releaseBuildingSlots(page.first, page.capacity);
+    page.first = first;
+    page.capacity = capacity;
+    page.buildings.clear();
+  }
 
-  std::vector<GLfloat> tiles;
-  tiles.resize(verticesCount);
+  // Chunk::removeBuilding() moves last building into the gap, so edits change few slots
+  auto same = [&page, &buildings](unsigned int i) {
+    if (i >= page.buildings.size()) {
+      return false;
+    }
+    const data::buildings::Building& a = buildings[i];
+    const data::buildings::Building& b = page.buildings[i];
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.length == b.length && a.level == b.level;
+  };
+  for (unsigned int i = 0; i < buildings.size();) {
+    if (same(i)) {
+      i++;
+      continue;
+    }
+    unsigned int end = i + 1;
+    while (end < buildings.size() && !same(end)) {
+      end++;
+    }
+    writeBuildingInstances(page.first + i, &buildings[i], end - i);
+    i = end;
+  }
+  if (page.buildings.size() > buildings.size()) {
+    clearBuildingInstances(page.first + buildings.size(), page.buildings.size() - buildings.size());
+  }
 
-  GLuint chunkVBO = 0;
-  std::vector<GLfloat> toBuffer;
-  toBuffer.resize(verticesCount * (3 + 1));
+  page.buildings = buildings;
+  buildingRanges[page.chunkIndex] = BuildingRange{page.first, (GLuint)buildings.size()};
+  return true;
+}
 
-  for (data::Chunk* chunk : world.getMap().getChunks()) {
-    glm::vec3 chunkPosition =
-        glm::vec3(chunk->getPosition().x, 0, chunk->getPosition().y) * (float)data::Chunk::SIDE_LENGTH;
+GLuint WorldRenderer::getPageCapacity(GLuint buildingCount) {
+  return buildingCount + buildingCount / 4 + 4;
+}
 
-    // Generate positions
-    for (unsigned int x = 0; x < data::Chunk::SIDE_LENGTH; x++) {
-      for (unsigned int y = 0; y < data::Chunk::SIDE_LENGTH; y++) {
-        for (unsigned int i = 0; i < 6; i++) {
-          positions[y * data::Chunk::SIDE_LENGTH * 6 + x * 6 + i] = chunkPosition + glm::vec3(x, 0, y) + fieldBase[i];
-        }
+bool WorldRenderer::allocateBuildingSlots(GLuint count, GLuint& first) {
+  for (auto it = freeBuildingSlots.begin(); it != freeBuildingSlots.end(); it++) {
+    if (it->second >= count) {
+      first = it->first;
+      it->first += count;
+      it->second -= count;
+      if (it->second == 0) {
+        freeBuildingSlots.erase(it);
       }
+      freeBuildingSlotCount -= count;
+      return true;
     }
+  }
+  return false;
+}
+
+void WorldRenderer::releaseBuildingSlots(GLuint first, GLuint count) {
+  freeBuildingSlots.push_back(std::make_pair(first, count));
+  freeBuildingSlotCount += count;
+}
+
+WorldRenderer::BuildingInstance WorldRenderer::getBuildingInstance(const data::buildings::Building& building) {
+  assert(std::numeric_limits<GLshort>::min() <= building.x && building.x <= std::numeric_limits<GLshort>::max());
+  assert(std::numeric_limits<GLshort>::min() <= building.y && building.y <= std::numeric_limits<GLshort>::max());
+  assert(building.width <= std::numeric_limits<GLubyte>::max());
+  assert(building.level <= std::numeric_limits<GLubyte>::max());
+  assert(building.length <= std::numeric_limits<GLubyte>::max());
+  BuildingInstance instance;
+  instance.x = building.x;
+  instance.y = building.y;
+  instance.width = building.width;
+  instance.level = building.level;
+  instance.length = building.length;
+  instance.padding = 0;
+  return instance;
+}
+
+void WorldRenderer::writeBuildingInstances(GLuint first, const data::buildings::Building* buildings, GLuint count) {
+  std::vector<BuildingInstance> instances(count);
+  for (GLuint i = 0; i < count; i++) {
+    instances[i] = getBuildingInstance(buildings[i]);
+  }
+  glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(BuildingInstance), instances.size() * sizeof(BuildingInstance),
+                  instances.data());
+}
+
+void WorldRenderer::clearBuildingInstances(GLuint first, GLuint count) {
+  const std::vector<BuildingInstance> instances(count, BuildingInstance{0, 0, 0, 0, 0, 0});
+  glBufferSubData(GL_ARRAY_BUFFER, first * sizeof(BuildingInstance), instances.size() * sizeof(BuildingInstance),
+                  instances.data());
+}
+
+void WorldRenderer::sendTileData() {
+  const std::vector<data::Chunk*> mapChunks = world.getMap().getChunks();
+  sendTileData(std::vector<const data::Chunk*>(mapChunks.begin(), mapChunks.end()));
+}
 
-    // Generate tiles
+void WorldRenderer::sendDirtyTileData() {
+  std::vector<const data::Chunk*> toSend;
+  for (const std::pair<int, int>& position : dirtyChunks) {
+    const glm::ivec2 chunkPosition = glm::ivec2(position.first, position.second);
+    if (world.getMap().chunkExists(chunkPosition)) {
+      toSend.push_back(&world.getMap().getChunk(chunkPosition));
+    }
+  }
+  sendTileData(toSend);
+}
+
+void WorldRenderer::sendTileData(const std::vector<const data::Chunk*>& toSend) {
+  constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+  std::vector<GLubyte> tiles;
+  tiles.resize(SIDE * SIDE);
+
+  glActiveTexture(GL_TEXTURE2);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, SIDE);
+  GLuint newChunkCount = 0;
+  for (const data::Chunk* chunk : toSend) {
+    if (chunks.find(std::make_pair(chunk->getPosition().x, chunk->getPosition().y)) == chunks.end()) {
+      newChunkCount++;
+    }
+  }
+  reserveTerrainLayers(terrainLayerCount + newChunkCount);
+
+  for (const data::Chunk* chunk : toSend) {
     std::fill(tiles.begin(), tiles.end(), 0);
 
     glm::ivec2 toBottomRight = chunk->getPosition() - glm::ivec2(1, 1);
@@ -474,44 +755,126 @@ void WorldRenderer::sendTileData() {
 
     this->paintOnTiles(*chunk, chunk->getPosition(), tiles);
 
-    // Concatenate
-    for (unsigned int i = 0; i < verticesCount; i++) {
-      toBuffer[i * 4] = positions[i].x;
-      toBuffer[i * 4 + 1] = positions[i].y;
-      toBuffer[i * 4 + 2] = positions[i].z;
-      toBuffer[i * 4 + 3] = tiles[i];
+    // Send texture
+    auto key = std::make_pair(chunk->getPosition().x, chunk->getPosition().y);
+    auto found = chunks.find(key);
+    if (found == chunks.end()) {
+      // Chunks are never removed, so layers are handed out in order
+      TerrainChunk terrainChunk;
+      terrainChunk.page = terrainLayerCount / terrainPageLayers;
+      terrainChunk.layer = terrainLayerCount % terrainPageLayers;
+      terrainLayerCount++;
+      glBindTexture(GL_TEXTURE_2D_ARRAY, terrainPages[terrainChunk.page]);
+      glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, terrainChunk.layer, SIDE, SIDE, 1, GL_RED_INTEGER,
+                      GL_UNSIGNED_BYTE, tiles.data());
+      terrainChunk.tiles = tiles;
+      chunks[key] = terrainChunk;
+      continue;
+    }
+
+    // Only the rectangle around changed tiles goes to the GPU
+    TerrainChunk& terrainChunk = found->second;
+    glm::ivec2 from = glm::ivec2(SIDE, SIDE);
+    glm::ivec2 to = glm::ivec2(-1, -1);
+    for (int y = 0; y < SIDE; y++) {
+      for (int x = 0; x < SIDE; x++) {
+        if (tiles[y * SIDE + x] != terrainChunk.tiles[y * SIDE + x]) {
+          from = glm::min(from, glm::ivec2(x, y));
+          to = glm::max(to, glm::ivec2(x, y));
+        }
+      }
     }
+    if (to.x < 0) {
+      continue;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, terrainPages[terrainChunk.page]);
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, from.x, from.y, terrainChunk.layer, to.x - from.x + 1, to.y - from.y + 1,
+                    1, GL_RED_INTEGER, GL_UNSIGNED_BYTE, &tiles[from.y * SIDE + from.x]);
+    terrainChunk.tiles = tiles;
+  }
 
-    // Send buffer
-    auto key = std::make_pair(chunk->getPosition().x, chunk->getPosition().y);
-    if (chunks.find(key) == chunks.end()) {
-      glGenBuffers(1, &chunkVBO);
-      chunks[key] = chunkVBO;
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+  glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+  glActiveTexture(GL_TEXTURE0);
+}
+
+void WorldRenderer::reserveTerrainLayers(GLuint layerCount) {
+  constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+  for (GLuint page = 0; page * terrainPageLayers < layerCount; page++) {
+    const GLint needed = std::min<GLint>(layerCount - page * terrainPageLayers, terrainPageLayers);
+    const GLint capacity = page < terrainPageCapacities.size() ? terrainPageCapacities[page] : 0;
+    if (needed <= capacity) {
+      continue;
+    }
+
+    // Doubling keeps re-uploads rare, layers of the old texture are sent again from copies
+    const GLint newCapacity = std::min(std::max(needed, 2 * capacity), terrainPageLayers);
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R8UI, SIDE, SIDE, newCapacity, 0, GL_RED_INTEGER, GL_UNSIGNED_BYTE,
+                 nullptr);
+    if (page < terrainPages.size()) {
+      for (const auto& entry : chunks) {
+        if (entry.second.page == page) {
+          glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, entry.second.layer, SIDE, SIDE, 1, GL_RED_INTEGER,
+                          GL_UNSIGNED_BYTE, entry.second.tiles.data());
+        }
+      }
+      glDeleteTextures(1, &terrainPages[page]);
+      terrainPages[page] = texture;
+      terrainPageCapacities[page] = newCapacity;
     } else {
-      chunkVBO = chunks[key];
+      terrainPages.push_back(texture);
+      terrainPageCapacities.push_back(newCapacity);
+    }
+  }
+}
+
+void WorldRenderer::sendTerrainInstances() {
+  const std::vector<data::Chunk*> mapChunks = world.getMap().getChunks();
+  std::vector<std::vector<TerrainInstance>> pageInstances(terrainPages.size());
+  for (unsigned int index : visibleChunks) {
+    const glm::ivec2 position = mapChunks[index]->getPosition();
+    auto found = chunks.find(std::make_pair(position.x, position.y));
+    if (found == chunks.end()) {
+      continue;
     }
-    glBindBuffer(GL_ARRAY_BUFFER, chunkVBO);
-    glBufferDataVector(GL_ARRAY_BUFFER, toBuffer, GL_STATIC_DRAW);
+    const glm::vec2 offset = glm::vec2(position) * (float)data::Chunk::SIDE_LENGTH;
+    pageInstances[found->second.page].push_back(TerrainInstance{offset.x, offset.y, (GLfloat)found->second.layer});
   }
 
+  std::vector<TerrainInstance> instances;
+  terrainDraws.clear();
+  for (GLuint page = 0; page < pageInstances.size(); page++) {
+    if (!pageInstances[page].empty()) {
+      terrainDraws.push_back(TerrainDraw{page, (GLuint)instances.size(), (GLuint)pageInstances[page].size()});
+      instances.insert(instances.end(), pageInstances[page].begin(), pageInstances[page].end());
+    }
+  }
+  if (instances.empty()) {
+    return;
+  }
+  glBindBuffer(GL_ARRAY_BUFFER, terrainInstanceVBO);
+  glBufferDataVector(GL_ARRAY_BUFFER, instances, GL_DYNAMIC_DRAW);
   glBindBuffer(GL_ARRAY_BUFFER, 0);
-  glBindVertexArray(0);
 }
 
 unsigned int WorldRenderer::getTile(int x, int y) const {
   return y * ATLAS_SIDE + x + 1;
 }
 
-void WorldRenderer::setTile(std::vector<GLfloat>& tiles, int x, int y, unsigned int tile) {
+void WorldRenderer::setTile(std::vector<GLubyte>& tiles, int x, int y, unsigned int tile) {
   if (x < 0 || (int)data::Chunk::SIDE_LENGTH <= x || y < 0 || (int)data::Chunk::SIDE_LENGTH <= y) {
     return;
   }
-  for (int i = 0; i < 6; i++) {
-    tiles[(y * data::Chunk::SIDE_LENGTH + x) * 6 + i] = tile;
-  }
+  tiles[y * data::Chunk::SIDE_LENGTH + x] = tile;
 }
 
-void WorldRenderer::paintOnTiles(const data::Chunk& chunk, const glm::ivec2& position, std::vector<GLfloat>& tiles) {
+void WorldRenderer::paintOnTiles(const data::Chunk& chunk, const glm::ivec2& position, std::vector<GLubyte>& tiles) {
   for (data::Lot lot : chunk.getLots()) {
     this->paintLotOnTiles(lot, position, tiles);
   }
@@ -523,7 +886,7 @@ void WorldRenderer::paintOnTiles(const data::Chunk& chunk, const glm::ivec2& pos
   }
 }
 
-void WorldRenderer::paintLotOnTiles(const data::Lot& lot, const glm::ivec2& position, std::vector<GLfloat>& tiles) {
+void WorldRenderer::paintLotOnTiles(const data::Lot& lot, const glm::ivec2& position, std::vector<GLubyte>& tiles) {
 
   int minX = lot.position.getLocal(position).x;
   int minY = lot.position.getLocal(position).y;
@@ -579,7 +942,7 @@ void WorldRenderer::paintLotOnTiles(const data::Lot& lot, const glm::ivec2& posi
   }
 }
 
-void WorldRenderer::paintRoadOnTiles(data::Road& road, const glm::ivec2& position, std::vector<GLfloat>& tiles) {
+void WorldRenderer::paintRoadOnTiles(data::Road& road, const glm::ivec2& position, std::vector<GLubyte>& tiles) {
 
   if (road.direction == data::Direction::N) {
     const int minX = road.position.getLocal(position).x;
@@ -613,7 +976,7 @@ void WorldRenderer::paintRoadOnTiles(data::Road& road, const glm::ivec2& positio
 }
 
 void WorldRenderer::paintRoadNodeOnTiles(const data::RoadGraph::Node& node, const glm::ivec2& position,
-                                         std::vector<GLfloat>& tiles) {
+                                         std::vector<GLubyte>& tiles) {
   int minX = node.position.getLocal(position).x;
   int minY = node.position.getLocal(position).y;
   int maxX = minX + node.size.x - 1;
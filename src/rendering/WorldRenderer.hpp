@@ -2,6 +2,7 @@
 #define RENDERING_WORLDRENDERER_HPP
 
 #include <map>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -16,6 +17,7 @@
 #include "../input/Selection.hpp"
 #include "../input/WindowHandler.hpp"
 #include "../settings.hpp"
+#include "../world/Frustum.hpp"
 #include "../world/World.hpp"
 #include "Renderer.hpp"
 #include "ShaderManager.hpp"
@@ -37,7 +39,11 @@ public:
   virtual void cleanup();
 
   void markBuildingDataForUpdate();
+  // Sends only changed buildings of given chunks
+  void markBuildingDataForUpdate(const std::vector<glm::ivec2>& changedChunks);
   void markTileDataForUpdate();
+  // Rebuilds tiles of given chunks only, along with neighbours they paint into
+  void markTileDataForUpdate(const std::vector<glm::ivec2>& changedChunks);
 
   void renderWorld(const input::Selection& selection);
   void renderDebug();
@@ -52,31 +58,110 @@ protected:
   world::World& world;
 
   bool resendBuildingData = false;
+  std::set<std::pair<int, int>> dirtyBuildingChunks;
   void sendBuildingData();
+  void sendDirtyBuildingData();
+  // False when chunk outgrew its page and there is no room for a bigger one
+  bool sendChunkBuildings(const data::Chunk& chunk);
+
+  // Building instances of each chunk, in order of Map::getChunks()
+  struct BuildingRange {
+    GLuint first;
+    GLuint count;
+  };
+  std::vector<BuildingRange> buildingRanges;
+
+  // Instance buffer is split into pages of slots, one per chunk, holding its buildings in order of
+  // Chunk::getResidentials(). Slots outside of ranges hold empty instances.
+  struct BuildingPage {
+    unsigned int chunkIndex;
+    GLuint first;
+    GLuint capacity;
+    // Copy of uploaded buildings, for sending changed slots only
+    std::vector<data::buildings::Building> buildings;
+  };
+  std::map<std::pair<int, int>, BuildingPage> buildingPages;
+  // Free ranges of slots as (first, count)
+  std::vector<std::pair<GLuint, GLuint>> freeBuildingSlots;
+  GLuint buildingSlotCount = 0;
+  GLuint freeBuildingSlotCount = 0;
+  static GLuint getPageCapacity(GLuint buildingCount);
+  bool allocateBuildingSlots(GLuint count, GLuint& first);
+  void releaseBuildingSlots(GLuint first, GLuint count);
+  // Tile position and size as they are, margin is applied in buildings.vs. Positions have to fit int16, so maps can
+  // span up to 512 chunks from origin.
+  struct BuildingInstance {
+    GLshort x, y;
+    GLubyte width, level, length, padding;
+  };
+  static BuildingInstance getBuildingInstance(const data::buildings::Building& building);
+  void writeBuildingInstances(GLuint first, const data::buildings::Building* buildings, GLuint count);
+  void clearBuildingInstances(GLuint first, GLuint count);
+
+  // Chunks of visible region passing frustum culling, in order of Map::getChunks(). Redone only when visible region
+  // or chunk bounds change. Stats for debug UI.
+  std::vector<unsigned int> visibleChunks;
+  unsigned long culledRegionVersion = 0;
+  unsigned int visibleChunkCount = 0;
+  unsigned int drawCount = 0;
+  void cullChunks(const glm::mat4& viewProjection);
+  // Merges instance ranges of neighbouring visible chunks into single draw
+  void drawVisibleBuildings();
+  void drawBuildingInstances(GLuint first, GLuint count);
 
   bool resendTileData = false;
+  std::set<std::pair<int, int>> dirtyChunks;
   void sendTileData();
+  void sendDirtyTileData();
+  void sendTileData(const std::vector<const data::Chunk*>& toSend);
 
   // Tiles
   const int ATLAS_SIDE = 10;
   unsigned int getTile(int x, int y) const;
-  void setTile(std::vector<GLfloat>& tiles, int x, int y, unsigned int tile);
+  void setTile(std::vector<GLubyte>& tiles, int x, int y, unsigned int tile);
 
-  void paintOnTiles(const data::Chunk& chunk, const glm::ivec2& position, std::vector<GLfloat>& tiles);
-  void paintLotOnTiles(const data::Lot& lot, const glm::ivec2& position, std::vector<GLfloat>& tiles);
-  void paintRoadOnTiles(data::Road& road, const glm::ivec2& position, std::vector<GLfloat>& tiles);
-  void paintRoadNodeOnTiles(const data::RoadGraph::Node& node, const glm::ivec2& position, std::vector<GLfloat>& tiles);
+  void paintOnTiles(const data::Chunk& chunk, const glm::ivec2& position, std::vector<GLubyte>& tiles);
+  void paintLotOnTiles(const data::Lot& lot, const glm::ivec2& position, std::vector<GLubyte>& tiles);
+  void paintRoadOnTiles(data::Road& road, const glm::ivec2& position, std::vector<GLubyte>& tiles);
+  void paintRoadNodeOnTiles(const data::RoadGraph::Node& node, const glm::ivec2& position, std::vector<GLubyte>& tiles);
 
-  // Terrain
+  // Terrain, chunks are instances of quad in terrainPositionVBO and keep tiles in a layer of texture array page
+  constexpr static unsigned int TERRAIN_VERTICES = 6;
   GLuint shaderProgram;
-  GLuint transformLoc, terrainPositionLoc, renderGridLoc, selectionLoc, selectionColorLoc, groundTextureLoc,
-      roadTextureLoc;
-  GLuint VBO, VAO, terrainPositionVBO;
+  GLuint transformLoc, renderGridLoc, selectionLoc, selectionColorLoc, groundTextureLoc,
+      roadTextureLoc, tileTextureLoc;
+  GLuint VBO, VAO, terrainPositionVBO, terrainInstanceVBO;
   GLuint gridTexture, roadTexture;
-  std::map<std::pair<int, int>, GLuint> chunks; // chunk -> VBO (roadTile)
+  struct TerrainChunk {
+    GLuint page;
+    GLuint layer;
+    // Copy of the layer, for sending changed tiles only
+    std::vector<GLubyte> tiles;
+  };
+  std::map<std::pair<int, int>, TerrainChunk> chunks;
+  std::vector<GLuint> terrainPages;
+  // Layers allocated in each page, at most terrainPageLayers
+  std::vector<GLint> terrainPageCapacities;
+  GLint terrainPageLayers = 0;
+  GLuint terrainLayerCount = 0;
+  // Grows pages to hold given number of layers, expects unpack state of sendTileData()
+  void reserveTerrainLayers(GLuint layerCount);
+
+  // Offset and layer of each visible chunk, grouped by page so every page takes one draw
+  struct TerrainInstance {
+    GLfloat x, y, layer;
+  };
+  struct TerrainDraw {
+    GLuint page;
+    GLuint first;
+    GLuint count;
+  };
+  std::vector<TerrainDraw> terrainDraws;
+  void sendTerrainInstances();
 
   // Buildings
-  GLuint buildingsVAO, buildingsVBO;
+  GLuint buildingsVAO, buildingsVBO, buildingsEBO;
+  GLsizei buildingsIndexCount;
   GLuint buildingsInstanceVBO;
   GLuint buildingsShaderProgram;
   GLuint buildingsTransformLoc;
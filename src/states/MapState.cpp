@@ -68,43 +68,9 @@ void MapState::update(std::chrono::milliseconds delta) {
     selection->to(selectionEnd);
   }
 
-  if (selection->isSelecting() && MapStateAction::PLACE_BUILDING == currentAction) {
-    glm::ivec2 size = selection->getTo() - selection->getFrom() + glm::ivec2(1, 1);
-    data::buildings::Building toAdd;
-    toAdd.width = size.x;
-    toAdd.length = size.y;
-    toAdd.level = newBuildingHeight;
-    toAdd.x = selection->getFrom().x;
-    toAdd.y = selection->getFrom().y;
-    if (!geometry.checkCollisions(toAdd)) {
-      selection->markValid();
-    } else {
-      selection->markInvalid();
-    }
-  }
-
-  if (selection->isSelecting() && MapStateAction::PLACE_ROAD == currentAction) {
-    glm::ivec2 size = selection->getTo() - selection->getFrom() + glm::ivec2(1, 1);
-    data::Road road;
-    road.setType(data::RoadTypes.Standard);
-    road.position.setGlobal(selection->getFrom());
-    if (size.x > size.y) {
-      road.direction = data::Direction::W;
-      road.length = size.x;
-    } else {
-      road.direction = data::Direction::N;
-      road.length = size.y;
-    }
-
-    // Collisions
-    bool valid = true;
-    const std::vector<data::Road> toInsert = geometry.splitRoadByChunks(road);
-    for (const data::Road& road : toInsert) {
-      if (geometry.checkCollisions(road)) {
-        valid = false;
-      }
-    }
-    if (valid) {
+  if (selection->isSelecting() &&
+      (MapStateAction::PLACE_BUILDING == currentAction || MapStateAction::PLACE_ROAD == currentAction)) {
+    if (isPlacementValid()) {
       selection->markValid();
     } else {
       selection->markInvalid();
@@ -229,42 +195,29 @@ void MapState::onMouseButton(int button, int action, int mods) {
   } else if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_RELEASE) {
     selection->stop();
 
-    if (MapStateAction::PLACE_BUILDING == currentAction) {
-      glm::ivec2 size = selection->getTo() - selection->getFrom() + glm::ivec2(1, 1);
-      data::buildings::Building toAdd;
-      toAdd.width = size.x;
-      toAdd.length = size.y;
-      toAdd.level = newBuildingHeight;
-      toAdd.x = selection->getFrom().x;
-      toAdd.y = selection->getFrom().y;
-      if (!geometry.checkCollisions(toAdd)) {
-        world.getMap().addBuilding(toAdd);
-        renderer.markBuildingDataForUpdate();
-      }
+    if (MapStateAction::PLACE_BUILDING == currentAction && isPlacementValid()) {
+      const data::buildings::Building building = getSelectedBuilding();
+      world.getMap().addBuilding(building);
+      renderer.markBuildingDataForUpdate({glm::ivec2(building.x, building.y) / (int)data::Chunk::SIDE_LENGTH});
     }
 
-    if (MapStateAction::PLACE_ROAD == currentAction) {
-      glm::ivec2 size = selection->getTo() - selection->getFrom() + glm::ivec2(1, 1);
-      data::Road road;
-      road.setType(data::RoadTypes.Standard);
-      road.position.setGlobal(selection->getFrom());
-      if (size.x > size.y) {
-        road.direction = data::Direction::W;
-        road.length = size.x;
-      } else {
-        road.direction = data::Direction::N;
-        road.length = size.y;
-      }
-      if (addRoadIfNoCollisions(road)) {
-        renderer.markTileDataForUpdate();
+    if (MapStateAction::PLACE_ROAD == currentAction && isPlacementValid()) {
+      const std::vector<data::Road> roads = geometry.splitRoadByChunks(getSelectedRoad());
+      world.getMap().addRoads(roads);
+      std::vector<glm::ivec2> changedChunks;
+      for (const data::Road& road : roads) {
+        changedChunks.push_back(road.position.getChunk());
       }
+      renderer.markTileDataForUpdate(changedChunks);
     }
 
     if (MapStateAction::BULDOZE == currentAction) {
+      std::vector<glm::ivec2> changedChunks;
       for (data::buildings::Building b : geometry.getBuildings(selection->getFrom(), selection->getTo())) {
         world.getMap().removeBuilding(b);
+        changedChunks.push_back(glm::ivec2(b.x, b.y) / (int)data::Chunk::SIDE_LENGTH);
       }
-      renderer.markBuildingDataForUpdate();
+      renderer.markBuildingDataForUpdate(changedChunks);
     }
   }
   if (button == GLFW_MOUSE_BUTTON_RIGHT) {
@@ -299,6 +252,16 @@ void MapState::createRandomWorld() {
   city.money = 445684;
   world.getMap().setCurrentCity(&city);
 
+  const world::settings::Scenario& scenario = engine.getSettings().world.scenario;
+  if (scenario.width > 0 && scenario.height > 0) {
+    engine.getLogger().info("Generating scenario of %ux%u chunks", scenario.width, scenario.height);
+    world::ScenarioGenerator(engine.getRandom().getSeed(), scenario).generate(world.getMap());
+    engine.getLogger().info("Scenario has %u buildings", world.getMap().getBuildingCount());
+    renderer.markTileDataForUpdate();
+    world.getCamera().move(glm::vec3(scenario.width, 0, scenario.height) * (data::Chunk::SIDE_LENGTH / 2.f));
+    return;
+  }
+
   const glm::ivec2 mapSize = glm::ivec2(2, 2);
   for (int x = 0; x < mapSize.x; x++) {
     for (int y = 0; y < mapSize.y; y++) {
@@ -355,27 +318,7 @@ void MapState::createRandomWorld() {
     addRoadIfNoCollisions(road);
   }*/
 
-  constexpr unsigned int minBuildingSide = 2;
-  constexpr unsigned int maxBuildingSideDifference = 3;
-  constexpr unsigned int minBuildingHeight = 1;
-  constexpr unsigned int maxBuildingHeightDifference = 6;
-  constexpr unsigned int maxCollisionTries = 20;
-  const unsigned int buildingCount =
-      (mapSize.x * mapSize.y) * (data::Chunk::SIDE_LENGTH * data::Chunk::SIDE_LENGTH / 4) * 0.02f;
-  for (unsigned int i = 0; i < buildingCount; i++) {
-    data::buildings::Building test;
-    for (unsigned int i = 0; i < maxCollisionTries; i++) {
-      test.width = rand() % maxBuildingSideDifference + minBuildingSide;
-      test.length = rand() % maxBuildingSideDifference + minBuildingSide;
-      test.level = rand() % maxBuildingHeightDifference + minBuildingHeight;
-      test.x = rand() % (data::Chunk::SIDE_LENGTH * mapSize.x - test.width + 1);
-      test.y = rand() % (data::Chunk::SIDE_LENGTH * mapSize.y - test.length + 1);
-      if (!geometry.checkCollisions(test)) {
-        world.getMap().addBuilding(test);
-        break;
-      }
-    }
-  }
+  world::WorldGenerator(engine.getRandom().getSeed()).populate(world.getMap());
 
   world.getCamera().move(glm::vec3(data::Chunk::SIDE_LENGTH, 0, data::Chunk::SIDE_LENGTH));
 }
@@ -415,6 +358,62 @@ void MapState::setCurrentAction(MapStateAction action) {
   }
 }
 
+bool MapState::isPlacementValid() {
+  const glm::ivec2 from = selection->getFrom();
+  const glm::ivec2 to = selection->getTo();
+  const unsigned long mapVersion = world.getMap().getEditVersion();
+  if (placementCheck.done && placementCheck.from == from && placementCheck.to == to &&
+      placementCheck.action == currentAction && placementCheck.mapVersion == mapVersion) {
+    return placementCheck.valid;
+  }
+
+  bool valid = true;
+  if (MapStateAction::PLACE_BUILDING == currentAction) {
+    valid = !geometry.checkCollisions(getSelectedBuilding());
+  } else if (MapStateAction::PLACE_ROAD == currentAction) {
+    for (const data::Road& road : geometry.splitRoadByChunks(getSelectedRoad())) {
+      if (geometry.checkCollisions(road)) {
+        valid = false;
+        break;
+      }
+    }
+  }
+
+  placementCheck.done = true;
+  placementCheck.from = from;
+  placementCheck.to = to;
+  placementCheck.action = currentAction;
+  placementCheck.mapVersion = mapVersion;
+  placementCheck.valid = valid;
+  return valid;
+}
+
+data::buildings::Building MapState::getSelectedBuilding() const {
+  const glm::ivec2 size = selection->getTo() - selection->getFrom() + glm::ivec2(1, 1);
+  data::buildings::Building building;
+  building.width = size.x;
+  building.length = size.y;
+  building.level = newBuildingHeight;
+  building.x = selection->getFrom().x;
+  building.y = selection->getFrom().y;
+  return building;
+}
+
+data::Road MapState::getSelectedRoad() const {
+  const glm::ivec2 size = selection->getTo() - selection->getFrom() + glm::ivec2(1, 1);
+  data::Road road;
+  road.setType(data::RoadTypes.Standard);
+  road.position.setGlobal(selection->getFrom());
+  if (size.x > size.y) {
+    road.direction = data::Direction::W;
+    road.length = size.x;
+  } else {
+    road.direction = data::Direction::N;
+    road.length = size.y;
+  }
+  return road;
+}
+
 void MapState::handleMapDragging(std::chrono::milliseconds delta) {
   const glm::vec2 mousePosition = engine.getWindowHandler().getMousePosition();
   const glm::vec2 dragDelta = mousePosition - dragStart;
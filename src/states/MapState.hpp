@@ -16,7 +16,9 @@
 #include "../settings.hpp"
 #include "../world/Camera.hpp"
 #include "../world/Geometry.hpp"
+#include "../world/ScenarioGenerator.hpp"
 #include "../world/World.hpp"
+#include "../world/WorldGenerator.hpp"
 #include "MapPauseState.hpp"
 
 namespace states {
@@ -53,6 +55,19 @@ private:
   MapStateAction currentAction;
   void setCurrentAction(MapStateAction action);
 
+  // Result of the last placement check, reused until selection, action or map changes
+  struct PlacementCheck {
+    bool done = false;
+    glm::ivec2 from;
+    glm::ivec2 to;
+    MapStateAction action;
+    unsigned long mapVersion;
+    bool valid;
+  } placementCheck;
+  bool isPlacementValid();
+  data::buildings::Building getSelectedBuilding() const;
+  data::Road getSelectedRoad() const;
+
   // TODO(kantoniak): Move actions to InputHandler
   glm::vec2 dragStart = glm::vec2();
   bool rmbPressed = false;
@@ -0,0 +1,179 @@
+#include "AreaSums.hpp"
+
+#include <numeric>
+
+namespace world {
+
+namespace {
+constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+}
+
+constexpr unsigned int AreaSums::QUANTITY_COUNT;
+
+void AreaSums::clear() {
+  chunks.clear();
+  dirtyChunks.clear();
+  gridFrom = gridSize = glm::ivec2(0, 0);
+  grid.clear();
+  rebuildChunkTables();
+}
+
+void AreaSums::addChunk(glm::ivec2 position) {
+  addChunks({position});
+}
+
+void AreaSums::addChunks(const std::vector<glm::ivec2>& positions) {
+  for (const glm::ivec2& position : positions) {
+    ChunkSums chunk;
+    chunk.position = position;
+    chunks.push_back(chunk);
+  }
+  if (chunks.empty()) {
+    return;
+  }
+
+  glm::ivec2 gridTo = chunks[0].position;
+  gridFrom = chunks[0].position;
+  for (const ChunkSums& other : chunks) {
+    gridFrom = glm::min(gridFrom, other.position);
+    gridTo = glm::max(gridTo, other.position);
+  }
+  gridSize = gridTo - gridFrom + glm::ivec2(1, 1);
+  grid.assign(gridSize.x * gridSize.y, -1);
+  for (unsigned int i = 0; i < chunks.size(); i++) {
+    const glm::ivec2 cell = chunks[i].position - gridFrom;
+    grid[cell.y * gridSize.x + cell.x] = i;
+  }
+  rebuildChunkTables();
+}
+
+void AreaSums::addBuilding(const data::buildings::Building& building) {
+  queueBuilding(building, 1);
+}
+
+void AreaSums::removeBuilding(const data::buildings::Building& building) {
+  queueBuilding(building, -1);
+}
+
+int64_t AreaSums::getSum(TileQuantity quantity, glm::ivec2 from, glm::ivec2 to) {
+  applyPending();
+  const unsigned int q = (unsigned int)quantity;
+  from = glm::max(from, gridFrom * SIDE);
+  to = glm::min(to, (gridFrom + gridSize) * SIDE - glm::ivec2(1, 1));
+  if (to.x < from.x || to.y < from.y) {
+    return 0;
+  }
+
+  // Chunks fully inside the rectangle
+  const glm::ivec2 chunkFrom = toChunk(from);
+  const glm::ivec2 chunkTo = toChunk(to);
+  const glm::ivec2 fromOffset = from - chunkFrom * SIDE;
+  const glm::ivec2 toOffset = to - chunkTo * SIDE;
+  const glm::ivec2 innerFrom = chunkFrom + glm::ivec2(fromOffset.x != 0, fromOffset.y != 0);
+  const glm::ivec2 innerTo = chunkTo - glm::ivec2(toOffset.x != SIDE - 1, toOffset.y != SIDE - 1);
+  int64_t sum = chunkTables[q].getSum(innerFrom - gridFrom, innerTo - gridFrom);
+
+  // Chunks on the border of the rectangle, each with its own table
+  const bool hasInner = innerFrom.x <= innerTo.x && innerFrom.y <= innerTo.y;
+  for (int y = chunkFrom.y; y <= chunkTo.y; y++) {
+    for (int x = chunkFrom.x; x <= chunkTo.x; x++) {
+      if (hasInner && innerFrom.y <= y && y <= innerTo.y && x == innerFrom.x) {
+        x = innerTo.x;
+        continue;
+      }
+      const int chunk = findChunk(glm::ivec2(x, y));
+      if (chunk < 0 || chunks[chunk].tables[q].getSize().x == 0) {
+        continue;
+      }
+      const glm::ivec2 origin = glm::ivec2(x, y) * SIDE;
+      sum += chunks[chunk].tables[q].getSum(from - origin, to - origin);
+    }
+  }
+  return sum;
+}
+
+void AreaSums::queueBuilding(const data::buildings::Building& building, int sign) {
+  const glm::ivec2 from = glm::ivec2(building.x, building.y);
+  const glm::ivec2 to = from + glm::ivec2(building.width - 1, building.length - 1);
+  for (int y = toChunk(from).y; y <= toChunk(to).y; y++) {
+    for (int x = toChunk(from).x; x <= toChunk(to).x; x++) {
+      const int chunk = findChunk(glm::ivec2(x, y));
+      if (chunk < 0) {
+        continue;
+      }
+      if (chunks[chunk].pending.empty()) {
+        dirtyChunks.push_back(chunk);
+      }
+      chunks[chunk].pending.push_back(std::make_pair(building, sign));
+    }
+  }
+}
+
+void AreaSums::applyPending() {
+  if (dirtyChunks.empty()) {
+    return;
+  }
+
+  std::array<std::vector<int32_t>, QUANTITY_COUNT> deltas;
+  for (int index : dirtyChunks) {
+    ChunkSums& chunk = chunks[index];
+    for (std::vector<int32_t>& delta : deltas) {
+      delta.assign(SIDE * SIDE, 0);
+    }
+
+    const glm::ivec2 origin = chunk.position * SIDE;
+    for (const std::pair<data::buildings::Building, int>& edit : chunk.pending) {
+      const data::buildings::Building& building = edit.first;
+      const glm::ivec2 start = glm::ivec2(building.x, building.y) - origin;
+      const glm::ivec2 from = glm::max(start, glm::ivec2(0, 0));
+      const glm::ivec2 to = glm::min(start + glm::ivec2(building.width, building.length), glm::ivec2(SIDE, SIDE));
+      for (int y = from.y; y < to.y; y++) {
+        for (int x = from.x; x < to.x; x++) {
+          deltas[(int)TileQuantity::FOOTPRINT][y * SIDE + x] += edit.second;
+          deltas[(int)TileQuantity::FLOOR_AREA][y * SIDE + x] += edit.second * building.level;
+        }
+      }
+      if (start == from) {
+        deltas[(int)TileQuantity::BUILDINGS][start.y * SIDE + start.x] += edit.second;
+      }
+    }
+    chunk.pending.clear();
+
+    const glm::ivec2 cell = chunk.position - gridFrom;
+    for (unsigned int q = 0; q < QUANTITY_COUNT; q++) {
+      if (chunk.tables[q].getSize().x == 0) {
+        chunk.tables[q].reset(glm::ivec2(SIDE, SIDE));
+      }
+      chunk.tables[q].add(deltas[q]);
+      chunkTables[q].add(cell, std::accumulate(deltas[q].begin(), deltas[q].end(), (int64_t)0));
+    }
+  }
+  dirtyChunks.clear();
+}
+
+void AreaSums::rebuildChunkTables() {
+  for (unsigned int q = 0; q < QUANTITY_COUNT; q++) {
+    std::vector<int64_t> totals(gridSize.x * gridSize.y, 0);
+    for (unsigned int i = 0; i < grid.size(); i++) {
+      if (grid[i] >= 0 && chunks[grid[i]].tables[q].getSize().x != 0) {
+        totals[i] = chunks[grid[i]].tables[q].getSum(glm::ivec2(0, 0), glm::ivec2(SIDE - 1, SIDE - 1));
+      }
+    }
+    chunkTables[q].reset(gridSize);
+    chunkTables[q].add(totals);
+  }
+}
+
+int AreaSums::findChunk(glm::ivec2 position) const {
+  const glm::ivec2 cell = position - gridFrom;
+  if (cell.x < 0 || cell.y < 0 || gridSize.x <= cell.x || gridSize.y <= cell.y) {
+    return -1;
+  }
+  return grid[cell.y * gridSize.x + cell.x];
+}
+
+glm::ivec2 AreaSums::toChunk(glm::ivec2 global) {
+  // Rounds towards negative infinity, unlike integer division
+  return glm::ivec2(glm::floor(glm::vec2(global) / (float)SIDE));
+}
+}
@@ -0,0 +1,73 @@
+#ifndef WORLD_AREASUMS_HPP
+#define WORLD_AREASUMS_HPP
+
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "../data/FenwickTable.hpp"
+#include "../data/SummedAreaTable.hpp"
+#include "../data/buildings.hpp"
+
+namespace world {
+
+// Per-tile values derived from buildings
+enum class TileQuantity {
+  // Tiles covered by buildings
+  FOOTPRINT = 0,
+  // Covered tiles times building level
+  FLOOR_AREA = 1,
+  // Buildings, counted on their first tile
+  BUILDINGS = 2
+};
+
+/**
+ * Sums of tile quantities over rectangles. Every chunk keeps summed-area table of its own tiles and Fenwick tree keeps
+ * totals of chunks, so chunks fully covered by the rectangle cost few lookups together. Edits are queued on chunks
+ * covered by the building and applied to their tables only by the next query, which updates totals of these chunks
+ * only.
+ */
+class AreaSums {
+
+public:
+  constexpr static unsigned int QUANTITY_COUNT = 3;
+
+  void clear();
+  void addChunk(glm::ivec2 position);
+  void addChunks(const std::vector<glm::ivec2>& positions);
+
+  void addBuilding(const data::buildings::Building& building);
+  void removeBuilding(const data::buildings::Building& building);
+
+  // Inclusive rectangle in global coordinates, tiles outside of chunks count as zero
+  int64_t getSum(TileQuantity quantity, glm::ivec2 from, glm::ivec2 to);
+
+protected:
+  struct ChunkSums {
+    glm::ivec2 position;
+    // Tables are allocated with the first edit
+    std::array<data::SummedAreaTable<int32_t>, QUANTITY_COUNT> tables;
+    std::vector<std::pair<data::buildings::Building, int>> pending;
+  };
+
+  std::vector<ChunkSums> chunks;
+  std::vector<int> dirtyChunks;
+
+  // Chunk grid spanning all chunks, with indices to chunks or -1 for holes
+  glm::ivec2 gridFrom = glm::ivec2(0, 0);
+  glm::ivec2 gridSize = glm::ivec2(0, 0);
+  std::vector<int> grid;
+  std::array<data::FenwickTable<int64_t>, QUANTITY_COUNT> chunkTables;
+
+  void queueBuilding(const data::buildings::Building& building, int sign);
+  void applyPending();
+  void rebuildChunkTables();
+  int findChunk(glm::ivec2 position) const;
+  static glm::ivec2 toChunk(glm::ivec2 global);
+};
+}
+
+#endif
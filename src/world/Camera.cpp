@@ -13,22 +13,26 @@ void Camera::init(PerspectiveState& initialPerspective, data::CameraState& camer
   this->updateViewMatrix();
   this->updateProjectionMatrix();
   this->updateViewProjectionMatrix();
+  this->version++;
 }
 
 void Camera::move(glm::vec3 movement) {
   this->cameraState.lookAt +=
       glm::vec3(glm::rotate(glm::mat4(1), -cameraState.rotationAroundY, glm::vec3(0, 1, 0)) * glm::vec4(movement, 1.f));
   this->viewChanged = true;
+  this->version++;
 }
 
 void Camera::zoom(float distanceDelta) {
   this->cameraState.distance = std::max(this->cameraState.distance - distanceDelta, 0.f);
   this->viewChanged = true;
+  this->version++;
 }
 
 void Camera::rotateAroundY(float angleDelta) {
   this->cameraState.rotationAroundY -= angleDelta;
   this->viewChanged = true;
+  this->version++;
 }
 
 void Camera::rotateAroundX(float angleDelta) {
@@ -39,18 +43,28 @@ void Camera::rotateAroundX(float angleDelta) {
 
   this->cameraState.rotationAroundX += angleDelta;
   this->viewChanged = true;
+  this->version++;
 }
 
 void Camera::updateAspect(float aspect) {
   this->perspectiveState.aspect = aspect;
   this->updateProjectionMatrix();
   this->updateViewProjectionMatrix();
+  this->version++;
 }
 
 float Camera::getFovy() {
   return this->perspectiveState.fovy;
 }
 
+float Camera::getZFar() {
+  return this->perspectiveState.zFar;
+}
+
+unsigned long Camera::getVersion() const {
+  return this->version;
+}
+
 glm::vec3 Camera::getPosition() {
   if (this->viewChanged) {
     this->updateViewProjectionMatrix();
@@ -26,6 +26,9 @@ public:
   void updateAspect(float aspect);
 
   float getFovy();
+  float getZFar();
+  // Changes with every move, zoom, rotation or aspect change, so users can cache what they derive from the camera
+  unsigned long getVersion() const;
 
   glm::vec3 getPosition();
   glm::vec3 getLookAt();
@@ -49,6 +52,7 @@ protected:
   data::CameraState cameraState;
 
   bool viewChanged = false;
+  unsigned long version = 0;
 
   void updateProjectionMatrix();
   void updateViewMatrix();
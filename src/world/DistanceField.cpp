@@ -0,0 +1,255 @@
+#include "DistanceField.hpp"
+
+#include <cmath>
+
+namespace world {
+
+namespace {
+constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+
+glm::ivec2 toChunk(glm::ivec2 global) {
+  return glm::ivec2(glm::floor(glm::vec2(global) / (float)SIDE));
+}
+}
+
+constexpr float DistanceField::FAR;
+
+DistanceField::SourceFunction DistanceField::roads() {
+  return [](const data::Chunk& chunk, std::vector<Rect>& sources) {
+    for (const data::Road& road : chunk.getRoads()) {
+      sources.push_back(std::make_pair(road.position.getGlobal(), road.getEnd()));
+    }
+  };
+}
+
+DistanceField::SourceFunction DistanceField::buildings(std::function<bool(const data::buildings::Building&)> filter) {
+  return [filter](const data::Chunk& chunk, std::vector<Rect>& sources) {
+    for (const data::buildings::Building& building : chunk.getResidentials()) {
+      if (!filter || filter(building)) {
+        const glm::ivec2 from = glm::ivec2(building.x, building.y);
+        sources.push_back(std::make_pair(from, from + glm::ivec2(building.width - 1, building.length - 1)));
+      }
+    }
+  };
+}
+
+DistanceField::DistanceField(Map& map, SourceFunction sources, DistanceMetric metric, unsigned int radius)
+    : map(map), sources(sources), metric(metric), radius(std::min(radius, (unsigned int)data::Chunk::SIDE_LENGTH)) {
+  rebuild();
+}
+
+void DistanceField::rebuild(unsigned int threadCount) {
+  chunks = map.getChunks();
+  chunkIndices.clear();
+  for (unsigned long i = 0; i < chunks.size(); i++) {
+    chunkIndices[std::make_pair(chunks[i]->getPosition().x, chunks[i]->getPosition().y)] = i;
+  }
+  masks.assign(chunks.size(), std::vector<uint8_t>());
+  fields.assign(chunks.size(), std::vector<float>());
+
+  // Fields read masks of neighbours, so all masks have to be ready first
+  parallelFor(chunks.size(), threadCount, [this](unsigned long chunk) { updateMask(chunk); });
+  parallelFor(chunks.size(), threadCount, [this](unsigned long chunk) { updateField(chunk); });
+}
+
+void DistanceField::update(glm::ivec2 from, glm::ivec2 to, unsigned int threadCount) {
+  if (chunks.size() != map.getChunksCount()) {
+    rebuild(threadCount);
+    return;
+  }
+
+  const std::vector<unsigned long> changed = getChunksIn(from, to);
+  parallelFor(changed.size(), threadCount, [&](unsigned long i) { updateMask(changed[i]); });
+  const std::vector<unsigned long> affected = getChunksIn(from - glm::ivec2(radius), to + glm::ivec2(radius));
+  parallelFor(affected.size(), threadCount, [&](unsigned long i) { updateField(affected[i]); });
+}
+
+float DistanceField::getDistance(glm::ivec2 global) const {
+  const long chunk = findChunk(toChunk(global));
+  if (chunk < 0) {
+    return FAR;
+  }
+  const glm::ivec2 local = global - chunks[chunk]->getPosition() * SIDE;
+  return fields[chunk][local.y * SIDE + local.x];
+}
+
+long DistanceField::findChunk(glm::ivec2 position) const {
+  const auto it = chunkIndices.find(std::make_pair(position.x, position.y));
+  return (it == chunkIndices.end()) ? -1 : (long)it->second;
+}
+
+std::vector<unsigned long> DistanceField::getChunksIn(glm::ivec2 from, glm::ivec2 to) const {
+  std::vector<unsigned long> result;
+  for (int x = toChunk(from).x; x <= toChunk(to).x; x++) {
+    for (int y = toChunk(from).y; y <= toChunk(to).y; y++) {
+      const long chunk = findChunk(glm::ivec2(x, y));
+      if (chunk >= 0) {
+        result.push_back(chunk);
+      }
+    }
+  }
+  return result;
+}
+
+void DistanceField::updateMask(unsigned long chunk) {
+  // Sources of neighbours can stick into this chunk
+  const glm::ivec2 position = chunks[chunk]->getPosition();
+  std::vector<Rect> rects;
+  for (int dx = -1; dx <= 1; dx++) {
+    for (int dy = -1; dy <= 1; dy++) {
+      const long other = findChunk(position + glm::ivec2(dx, dy));
+      if (other >= 0) {
+        sources(*chunks[other], rects);
+      }
+    }
+  }
+
+  std::vector<uint8_t>& mask = masks[chunk];
+  mask.assign(SIDE * SIDE, 0);
+  const glm::ivec2 origin = position * SIDE;
+  for (const Rect& rect : rects) {
+    const glm::ivec2 from = glm::max(rect.first - origin, glm::ivec2(0, 0));
+    const glm::ivec2 to = glm::min(rect.second - origin, glm::ivec2(SIDE - 1, SIDE - 1));
+    for (int y = from.y; y <= to.y; y++) {
+      for (int x = from.x; x <= to.x; x++) {
+        mask[y * SIDE + x] = 1;
+      }
+    }
+  }
+}
+
+void DistanceField::updateField(unsigned long chunk) {
+  // Window reaching radius into neighbours holds every source closer than radius
+  const int size = SIDE + 2 * radius;
+  const glm::ivec2 position = chunks[chunk]->getPosition();
+  const glm::ivec2 windowOrigin = position * SIDE - glm::ivec2(radius);
+  std::vector<float> window(size * size, FAR);
+  for (int dx = -1; dx <= 1; dx++) {
+    for (int dy = -1; dy <= 1; dy++) {
+      const long other = findChunk(position + glm::ivec2(dx, dy));
+      if (other < 0) {
+        continue;
+      }
+      const glm::ivec2 offset = (position + glm::ivec2(dx, dy)) * SIDE - windowOrigin;
+      const glm::ivec2 from = glm::max(-offset, glm::ivec2(0, 0));
+      const glm::ivec2 to = glm::min(glm::ivec2(size) - offset, glm::ivec2(SIDE, SIDE));
+      for (int y = from.y; y < to.y; y++) {
+        for (int x = from.x; x < to.x; x++) {
+          if (masks[other][y * SIDE + x]) {
+            window[(y + offset.y) * size + x + offset.x] = 0;
+          }
+        }
+      }
+    }
+  }
+
+  if (DistanceMetric::MANHATTAN == metric) {
+    transformManhattan(window, size);
+  } else {
+    transformEuclidean(window, size);
+  }
+
+  std::vector<float>& field = fields[chunk];
+  field.resize(SIDE * SIDE);
+  for (int y = 0; y < SIDE; y++) {
+    for (int x = 0; x < SIDE; x++) {
+      const float distance = window[(y + radius) * size + x + radius];
+      field[y * SIDE + x] = (distance <= radius) ? distance : FAR;
+    }
+  }
+}
+
+void DistanceField::transformManhattan(std::vector<float>& grid, int size) {
+  // Two sweeps are exact for city block distance
+  for (int y = 0; y < size; y++) {
+    for (int x = 0; x < size; x++) {
+      float& value = grid[y * size + x];
+      if (x > 0) {
+        value = std::min(value, grid[y * size + x - 1] + 1);
+      }
+      if (y > 0) {
+        value = std::min(value, grid[(y - 1) * size + x] + 1);
+      }
+    }
+  }
+  for (int y = size - 1; y >= 0; y--) {
+    for (int x = size - 1; x >= 0; x--) {
+      float& value = grid[y * size + x];
+      if (x < size - 1) {
+        value = std::min(value, grid[y * size + x + 1] + 1);
+      }
+      if (y < size - 1) {
+        value = std::min(value, grid[(y + 1) * size + x] + 1);
+      }
+    }
+  }
+}
+
+void DistanceField::transformEuclidean(std::vector<float>& grid, int size) {
+  // Felzenszwalb-Huttenlocher: distance along columns first, then parabolas along rows
+  for (int x = 0; x < size; x++) {
+    for (int y = 1; y < size; y++) {
+      grid[y * size + x] = std::min(grid[y * size + x], grid[(y - 1) * size + x] + 1);
+    }
+    for (int y = size - 2; y >= 0; y--) {
+      grid[y * size + x] = std::min(grid[y * size + x], grid[(y + 1) * size + x] + 1);
+    }
+  }
+  for (float& value : grid) {
+    value *= value;
+  }
+
+  std::vector<float> row(size);
+  std::vector<int> vertices(size);
+  std::vector<float> bounds(size + 1);
+  for (int y = 0; y < size; y++) {
+    transformRow(&grid[y * size], size, row.data(), vertices, bounds);
+    for (int x = 0; x < size; x++) {
+      grid[y * size + x] = std::sqrt(row[x]);
+    }
+  }
+}
+
+void DistanceField::transformRow(const float* squared, int count, float* result, std::vector<int>& vertices,
+                                 std::vector<float>& bounds) {
+  // Parabolas of tiles with no source in their column are skipped, as they would never be the lowest
+  int k = -1;
+  for (int q = 0; q < count; q++) {
+    if (std::isinf(squared[q])) {
+      continue;
+    }
+    if (k < 0) {
+      k = 0;
+      vertices[0] = q;
+      bounds[0] = -FAR;
+      bounds[1] = FAR;
+      continue;
+    }
+    float s;
+    while (true) {
+      const int v = vertices[k];
+      s = ((squared[q] + q * q) - (squared[v] + v * v)) / (2.f * (q - v));
+      if (s > bounds[k]) {
+        break;
+      }
+      k--;
+    }
+    k++;
+    vertices[k] = q;
+    bounds[k] = s;
+    bounds[k + 1] = FAR;
+  }
+
+  if (k < 0) {
+    std::fill(result, result + count, FAR);
+    return;
+  }
+  k = 0;
+  for (int x = 0; x < count; x++) {
+    while (bounds[k + 1] < x) {
+      k++;
+    }
+    result[x] = (x - vertices[k]) * (x - vertices[k]) + squared[vertices[k]];
+  }
+}
+}
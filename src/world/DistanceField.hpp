@@ -0,0 +1,73 @@
+#ifndef WORLD_DISTANCEFIELD_HPP
+#define WORLD_DISTANCEFIELD_HPP
+
+#include <functional>
+#include <glm/glm.hpp>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "Map.hpp"
+#include "ParallelFor.hpp"
+
+namespace world {
+
+enum class DistanceMetric { MANHATTAN, EUCLIDEAN };
+
+/**
+ * Distance from every tile of the map to the nearest source tile, up to given radius. Radius is at most chunk side,
+ * so each chunk is computed on its own from sources of itself and its neighbours, in linear time and in parallel.
+ * When sources change, only chunks within radius of the change are computed again.
+ */
+class DistanceField {
+
+public:
+  typedef std::pair<glm::ivec2, glm::ivec2> Rect;
+  // Appends inclusive global rectangles of sources belonging to given chunk
+  typedef std::function<void(const data::Chunk& chunk, std::vector<Rect>& sources)> SourceFunction;
+
+  constexpr static float FAR = std::numeric_limits<float>::infinity();
+
+  static SourceFunction roads();
+  static SourceFunction buildings(std::function<bool(const data::buildings::Building&)> filter = nullptr);
+
+  DistanceField(Map& map, SourceFunction sources, DistanceMetric metric, unsigned int radius);
+
+  /**
+   * @param threadCount 0 uses all hardware threads
+   */
+  void rebuild(unsigned int threadCount = 0);
+  // Call after sources within inclusive global rectangle changed
+  void update(glm::ivec2 from, glm::ivec2 to, unsigned int threadCount = 0);
+
+  // FAR when beyond radius or outside of the map
+  float getDistance(glm::ivec2 global) const;
+
+protected:
+  Map& map;
+  SourceFunction sources;
+  DistanceMetric metric;
+  int radius;
+
+  std::vector<data::Chunk*> chunks;
+  std::map<std::pair<int, int>, unsigned long> chunkIndices;
+  // Per chunk, row by row in local coordinates
+  std::vector<std::vector<uint8_t>> masks;
+  std::vector<std::vector<float>> fields;
+
+  long findChunk(glm::ivec2 position) const;
+  std::vector<unsigned long> getChunksIn(glm::ivec2 from, glm::ivec2 to) const;
+  void updateMask(unsigned long chunk);
+  void updateField(unsigned long chunk);
+
+  static void transformManhattan(std::vector<float>& grid, int size);
+  static void transformEuclidean(std::vector<float>& grid, int size);
+  // Lower envelope of parabolas rooted at squared distances of single row
+  static void transformRow(const float* squared, int count, float* result, std::vector<int>& vertices,
+                           std::vector<float>& bounds);
+};
+}
+
+#endif
@@ -0,0 +1,256 @@
+#include "FlowField.hpp"
+
+namespace world {
+
+namespace {
+constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+
+const glm::ivec2 DIRECTIONS[] = {glm::ivec2(1, 0),  glm::ivec2(-1, 0), glm::ivec2(0, 1),  glm::ivec2(0, -1),
+                                 glm::ivec2(1, 1),  glm::ivec2(-1, 1), glm::ivec2(1, -1), glm::ivec2(-1, -1)};
+
+glm::ivec2 toChunk(glm::ivec2 global) {
+  return glm::ivec2(glm::floor(glm::vec2(global) / (float)SIDE));
+}
+
+float getStepCost(glm::ivec2 direction) {
+  return (direction.x != 0 && direction.y != 0) ? std::sqrt(2.f) : 1.f;
+}
+}
+
+constexpr float FlowField::UNREACHABLE;
+constexpr uint8_t FlowField::NO_DIRECTION;
+constexpr unsigned int FlowField::TILES;
+
+FlowField::FlowField(Map& map, const Pathfinder& pathfinder, const std::vector<glm::ivec2>& goals)
+    : map(map), pathfinder(pathfinder), goals(goals) {
+  rebuild();
+}
+
+void FlowField::rebuild() {
+  const std::vector<data::Chunk*> chunks = map.getChunks();
+  minChunk = chunks.empty() ? glm::ivec2(0, 0) : chunks[0]->getPosition();
+  glm::ivec2 maxChunk = minChunk - glm::ivec2(1, 1);
+  for (const data::Chunk* chunk : chunks) {
+    minChunk = glm::min(minChunk, chunk->getPosition());
+    maxChunk = glm::max(maxChunk, chunk->getPosition());
+  }
+  chunkGridSize = maxChunk - minChunk + glm::ivec2(1, 1);
+  slots.assign(chunkGridSize.x * chunkGridSize.y, -1);
+  fields.resize(chunks.size());
+  for (unsigned long i = 0; i < chunks.size(); i++) {
+    const glm::ivec2 position = chunks[i]->getPosition();
+    slots[(position.y - minChunk.y) * chunkGridSize.x + position.x - minChunk.x] = i;
+    fields[i].position = position;
+    fields[i].costs.assign(TILES, UNREACHABLE);
+  }
+
+  touched.assign(fields.size(), false);
+  for (const glm::ivec2& goal : goals) {
+    if (pathfinder.isFree(goal)) {
+      addSeed(findTile(goal), 0);
+    }
+  }
+  propagate();
+  for (unsigned long slot = 0; slot < fields.size(); slot++) {
+    updateDirections(slot);
+  }
+}
+
+void FlowField::update(glm::ivec2 from, glm::ivec2 to) {
+  if (fields.size() != map.getChunksCount()) {
+    rebuild();
+    return;
+  }
+
+  // Diagonal steps check corners, so tiles next to the rectangle can change too
+  std::vector<bool> invalid(fields.size(), false);
+  for (int x = toChunk(from - glm::ivec2(1, 1)).x; x <= toChunk(to + glm::ivec2(1, 1)).x; x++) {
+    for (int y = toChunk(from - glm::ivec2(1, 1)).y; y <= toChunk(to + glm::ivec2(1, 1)).y; y++) {
+      const long slot = findSlot(glm::ivec2(x, y));
+      if (slot >= 0) {
+        invalid[slot] = true;
+      }
+    }
+  }
+
+  // Costs can grow only where flow passes through changed chunks
+  for (bool grown = true; grown;) {
+    grown = false;
+    for (unsigned long slot = 0; slot < fields.size(); slot++) {
+      for (int bit = 0; bit < 9 && !invalid[slot]; bit++) {
+        const long target = findSlot(fields[slot].position + glm::ivec2(bit % 3 - 1, bit / 3 - 1));
+        if ((fields[slot].exits >> bit & 1) && target >= 0 && invalid[target]) {
+          invalid[slot] = true;
+          grown = true;
+        }
+      }
+    }
+  }
+
+  touched.assign(fields.size(), false);
+  for (unsigned long slot = 0; slot < fields.size(); slot++) {
+    if (invalid[slot]) {
+      std::fill(fields[slot].costs.begin(), fields[slot].costs.end(), UNREACHABLE);
+      touched[slot] = true;
+    }
+  }
+  for (const glm::ivec2& goal : goals) {
+    const long tile = findTile(goal);
+    if (tile >= 0 && invalid[tile / TILES] && pathfinder.isFree(goal)) {
+      addSeed(tile, 0);
+    }
+  }
+  // Valid chunks flow into invalid ones only through their border tiles
+  for (unsigned long slot = 0; slot < fields.size(); slot++) {
+    if (invalid[slot]) {
+      continue;
+    }
+    bool nextToInvalid = false;
+    for (int dx = -1; dx <= 1; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        const long other = findSlot(fields[slot].position + glm::ivec2(dx, dy));
+        nextToInvalid |= (other >= 0 && invalid[other]);
+      }
+    }
+    for (int i = 0; nextToInvalid && i < SIDE; i++) {
+      for (const glm::ivec2& local :
+           {glm::ivec2(i, 0), glm::ivec2(i, SIDE - 1), glm::ivec2(0, i), glm::ivec2(SIDE - 1, i)}) {
+        const uint32_t tile = slot * TILES + local.y * SIDE + local.x;
+        if (getTileCost(tile) != UNREACHABLE) {
+          heap.push_back(std::make_pair(getTileCost(tile), tile));
+        }
+      }
+    }
+  }
+  std::make_heap(heap.begin(), heap.end(), std::greater<std::pair<float, uint32_t>>());
+  propagate();
+
+  // Directions of border tiles look into neighbouring chunks
+  std::vector<bool> changed = touched;
+  for (unsigned long slot = 0; slot < fields.size(); slot++) {
+    for (int dx = -1; dx <= 1 && touched[slot]; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        const long other = findSlot(fields[slot].position + glm::ivec2(dx, dy));
+        if (other >= 0) {
+          changed[other] = true;
+        }
+      }
+    }
+  }
+  for (unsigned long slot = 0; slot < fields.size(); slot++) {
+    if (changed[slot]) {
+      updateDirections(slot);
+    }
+  }
+}
+
+float FlowField::getCost(glm::ivec2 global) const {
+  const long tile = findTile(global);
+  return (tile < 0) ? UNREACHABLE : fields[tile / TILES].costs[tile % TILES];
+}
+
+glm::ivec2 FlowField::getStep(glm::ivec2 global) const {
+  const long tile = findTile(global);
+  if (tile < 0) {
+    return glm::ivec2(0, 0);
+  }
+  const uint8_t direction = fields[tile / TILES].directions[tile % TILES];
+  return (direction == NO_DIRECTION) ? glm::ivec2(0, 0) : DIRECTIONS[direction];
+}
+
+long FlowField::findSlot(glm::ivec2 chunkPosition) const {
+  const glm::ivec2 offset = chunkPosition - minChunk;
+  if (offset.x < 0 || offset.y < 0 || offset.x >= chunkGridSize.x || offset.y >= chunkGridSize.y) {
+    return -1;
+  }
+  return slots[offset.y * chunkGridSize.x + offset.x];
+}
+
+long FlowField::findTile(glm::ivec2 global) const {
+  const glm::ivec2 chunk = toChunk(global);
+  const long slot = findSlot(chunk);
+  if (slot < 0) {
+    return -1;
+  }
+  const glm::ivec2 local = global - chunk * SIDE;
+  return slot * TILES + local.y * SIDE + local.x;
+}
+
+glm::ivec2 FlowField::getGlobal(uint32_t tile) const {
+  const unsigned int local = tile % TILES;
+  return fields[tile / TILES].position * SIDE + glm::ivec2(local % SIDE, local / SIDE);
+}
+
+float& FlowField::getTileCost(uint32_t tile) {
+  return fields[tile / TILES].costs[tile % TILES];
+}
+
+void FlowField::addSeed(uint32_t tile, float cost) {
+  getTileCost(tile) = cost;
+  heap.push_back(std::make_pair(cost, tile));
+  std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<float, uint32_t>>());
+}
+
+void FlowField::propagate() {
+  const auto later = std::greater<std::pair<float, uint32_t>>();
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const float cost = heap.back().first;
+    const uint32_t tile = heap.back().second;
+    heap.pop_back();
+    if (cost > getTileCost(tile)) {
+      continue;
+    }
+
+    // Moves are symmetric, so walking out of the goals finds the same costs as walking into them
+    const glm::ivec2 global = getGlobal(tile);
+    for (const glm::ivec2& direction : DIRECTIONS) {
+      const glm::ivec2 next = global + direction;
+      if (!pathfinder.isFree(next) || !pathfinder.isFree(global + glm::ivec2(direction.x, 0)) ||
+          !pathfinder.isFree(global + glm::ivec2(0, direction.y))) {
+        continue;
+      }
+      const uint32_t nextTile = findTile(next);
+      const float nextCost = cost + getStepCost(direction);
+      if (nextCost < getTileCost(nextTile)) {
+        getTileCost(nextTile) = nextCost;
+        touched[nextTile / TILES] = true;
+        heap.push_back(std::make_pair(nextCost, nextTile));
+        std::push_heap(heap.begin(), heap.end(), later);
+      }
+    }
+  }
+}
+
+void FlowField::updateDirections(unsigned long slot) {
+  ChunkField& field = fields[slot];
+  field.directions.assign(TILES, NO_DIRECTION);
+  field.exits = 0;
+  for (unsigned int local = 0; local < TILES; local++) {
+    const float cost = field.costs[local];
+    if (cost == 0 || cost == UNREACHABLE) {
+      continue;
+    }
+
+    const glm::ivec2 global = field.position * SIDE + glm::ivec2(local % SIDE, local / SIDE);
+    float best = UNREACHABLE;
+    for (uint8_t i = 0; i < NO_DIRECTION; i++) {
+      const glm::ivec2 next = global + DIRECTIONS[i];
+      if (!pathfinder.isFree(next) || !pathfinder.isFree(global + glm::ivec2(DIRECTIONS[i].x, 0)) ||
+          !pathfinder.isFree(global + glm::ivec2(0, DIRECTIONS[i].y))) {
+        continue;
+      }
+      const float nextCost = getCost(next) + getStepCost(DIRECTIONS[i]);
+      if (nextCost < best) {
+        best = nextCost;
+        field.directions[local] = i;
+      }
+    }
+
+    if (field.directions[local] != NO_DIRECTION) {
+      const glm::ivec2 exit = toChunk(global + DIRECTIONS[field.directions[local]]) - field.position;
+      field.exits |= 1 << ((exit.y + 1) * 3 + exit.x + 1);
+    }
+  }
+}
+}
@@ -0,0 +1,79 @@
+#ifndef WORLD_FLOWFIELD_HPP
+#define WORLD_FLOWFIELD_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "Map.hpp"
+#include "Pathfinder.hpp"
+
+namespace world {
+
+/**
+ * Walking cost from every tile to the nearest of shared goal tiles, with direction of the next step, so crowds
+ * heading to the same place need no search of their own. Uses occupancy and moves of given Pathfinder.
+ *
+ * Costs and directions are kept per chunk. After obstacles change, update() recomputes the changed chunks and all
+ * chunks whose flow passes through them, then lets improvements spread to the rest.
+ */
+class FlowField {
+
+public:
+  constexpr static float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+  FlowField(Map& map, const Pathfinder& pathfinder, const std::vector<glm::ivec2>& goals);
+
+  void rebuild();
+  // Call after Pathfinder::update() for the same inclusive global rectangle
+  void update(glm::ivec2 from, glm::ivec2 to);
+
+  float getCost(glm::ivec2 global) const;
+  // Offset of the next tile towards closest goal, zero at goals and where no goal can be reached
+  glm::ivec2 getStep(glm::ivec2 global) const;
+
+protected:
+  constexpr static uint8_t NO_DIRECTION = 8;
+  constexpr static unsigned int TILES = data::Chunk::SIDE_LENGTH * data::Chunk::SIDE_LENGTH;
+
+  struct ChunkField {
+    glm::ivec2 position;
+    // Row by row in local coordinates
+    std::vector<float> costs;
+    std::vector<uint8_t> directions;
+    // Bit (dy + 1) * 3 + dx + 1 set for every neighbouring chunk the flow leaves this one to
+    uint16_t exits;
+  };
+
+  Map& map;
+  const Pathfinder& pathfinder;
+  std::vector<glm::ivec2> goals;
+
+  // Slot of each chunk in bounding box of chunks, -1 where there is no chunk
+  glm::ivec2 minChunk;
+  glm::ivec2 chunkGridSize;
+  std::vector<long> slots;
+  std::vector<ChunkField> fields;
+
+  // Tile ids are slot * TILES + local index
+  std::vector<std::pair<float, uint32_t>> heap;
+  std::vector<bool> touched;
+
+  long findSlot(glm::ivec2 chunkPosition) const;
+  long findTile(glm::ivec2 global) const;
+  glm::ivec2 getGlobal(uint32_t tile) const;
+  float& getTileCost(uint32_t tile);
+
+  void addSeed(uint32_t tile, float cost);
+  // Dijkstra from seeds, lowering costs only
+  void propagate();
+  void updateDirections(unsigned long slot);
+};
+}
+
+#endif
@@ -0,0 +1,38 @@
+#include "Frustum.hpp"
+
+namespace world {
+
+Frustum::Frustum(const glm::mat4& viewProjection) {
+  const glm::mat4 rows = glm::transpose(viewProjection);
+  planes[0] = rows[3] + rows[0];
+  planes[1] = rows[3] - rows[0];
+  planes[2] = rows[3] + rows[1];
+  planes[3] = rows[3] - rows[1];
+  planes[4] = rows[3] + rows[2];
+  planes[5] = rows[3] - rows[2];
+}
+
+bool Frustum::intersects(glm::vec3 min, glm::vec3 max) const {
+  for (const glm::vec4& plane : planes) {
+    // Corner furthest along the normal
+    const glm::vec3 corner = glm::vec3(plane.x > 0 ? max.x : min.x, plane.y > 0 ? max.y : min.y,
+                                       plane.z > 0 ? max.z : min.z);
+    if (glm::dot(glm::vec3(plane), corner) + plane.w < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<unsigned int> cullChunks(const std::vector<data::Chunk*>& chunks, const Frustum& frustum) {
+  std::vector<unsigned int> result;
+  for (unsigned int i = 0; i < chunks.size(); i++) {
+    glm::vec3 min, max;
+    chunks[i]->getBounds(min, max);
+    if (frustum.intersects(min, max)) {
+      result.push_back(i);
+    }
+  }
+  return result;
+}
+}
@@ -0,0 +1,32 @@
+#ifndef WORLD_FRUSTUM_HPP
+#define WORLD_FRUSTUM_HPP
+
+#include <array>
+#include <glm/glm.hpp>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+
+namespace world {
+
+/**
+ * View frustum as six planes taken from view-projection matrix, for culling boxes in world space.
+ */
+class Frustum {
+
+public:
+  Frustum(const glm::mat4& viewProjection);
+
+  // Conservative, boxes near edges of the frustum can pass even when they are just outside
+  bool intersects(glm::vec3 min, glm::vec3 max) const;
+
+protected:
+  // Normal in xyz, offset in w, pointing inside
+  std::array<glm::vec4, 6> planes;
+};
+
+// Indices of chunks whose bounds, buildings included, intersect the frustum
+std::vector<unsigned int> cullChunks(const std::vector<data::Chunk*>& chunks, const Frustum& frustum);
+}
+
+#endif
@@ -1,7 +1,9 @@
 #include "Geometry.hpp"
 
 #include "glm/gtx/string_cast.hpp"
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 namespace world {
 void Geometry::init(engine::Engine& engine, World& world) {
@@ -27,9 +29,98 @@ bool Geometry::hitField(glm::vec2 entryPoint, glm::ivec2& hit) {
     return false;
   }
   hit = pointToField(ground);
+
+  // Building standing in front of the ground takes the hit, clamped to its footprint as ray can hit far walls
+  Camera camera = getWorld().getCamera();
+  const glm::vec3 cameraPos = camera.getPosition();
+  const glm::vec3 ray = camera.getRay(entryPoint);
+  float distance = -cameraPos.y / ray.y;
+  data::buildings::Building building;
+  if (hitBuilding(cameraPos, ray, distance, building)) {
+    hit = glm::clamp(pointToField(cameraPos + distance * ray), glm::ivec2(building.x, building.y), getEnd(building));
+  }
   return true;
 }
 
+bool Geometry::hitBuilding(glm::vec2 entryPoint, data::buildings::Building& hit) {
+  Camera camera = getWorld().getCamera();
+  float distance = std::numeric_limits<float>::infinity();
+  return hitBuilding(camera.getPosition(), camera.getRay(entryPoint), distance, hit);
+}
+
+bool Geometry::hitBuilding(glm::vec3 origin, glm::vec3 ray, float& distance, data::buildings::Building& hit) {
+  Map& map = getWorld().getMap();
+  const float height = map.getMaxBuildingSize().y;
+  glm::ivec2 chunkFrom, chunkTo;
+  if (height <= 0 || !map.getChunkBounds(chunkFrom, chunkTo)) {
+    return false;
+  }
+
+  // Clip the ray to box around all buildings, they stick out of the last chunks by less than chunk side
+  const float side = data::Chunk::SIDE_LENGTH;
+  const glm::vec3 boxMin = glm::vec3(chunkFrom.x, 0, chunkFrom.y) * side;
+  const glm::vec3 boxMax = glm::vec3((chunkTo.x + 2) * side, height, (chunkTo.y + 2) * side);
+  float entry = 0;
+  float exit = distance;
+  for (int axis = 0; axis < 3; axis++) {
+    if (ray[axis] == 0) {
+      if (origin[axis] < boxMin[axis] || boxMax[axis] < origin[axis]) {
+        return false;
+      }
+      continue;
+    }
+    const float t1 = (boxMin[axis] - origin[axis]) / ray[axis];
+    const float t2 = (boxMax[axis] - origin[axis]) / ray[axis];
+    entry = std::max(entry, std::min(t1, t2));
+    exit = std::min(exit, std::max(t1, t2));
+  }
+  if (exit < entry) {
+    return false;
+  }
+
+  // Walk chunk cells crossed by the ray in order, distances to next cell border and between borders per axis
+  const glm::vec2 flatOrigin = glm::vec2(origin.x, origin.z);
+  const glm::vec2 flatRay = glm::vec2(ray.x, ray.z);
+  const glm::vec3 start = origin + entry * ray;
+  glm::ivec2 cell = glm::clamp(fieldToChunk(pointToField(start)), chunkFrom, chunkTo + glm::ivec2(1, 1));
+  const glm::ivec2 step = glm::ivec2(flatRay.x < 0 ? -1 : 1, flatRay.y < 0 ? -1 : 1);
+  glm::vec2 next, delta;
+  for (int axis = 0; axis < 2; axis++) {
+    if (flatRay[axis] == 0) {
+      next[axis] = delta[axis] = std::numeric_limits<float>::infinity();
+      continue;
+    }
+    const float border = (cell[axis] + (step[axis] > 0 ? 1 : 0)) * side;
+    next[axis] = (border - flatOrigin[axis]) / flatRay[axis];
+    delta[axis] = side / std::abs(flatRay[axis]);
+  }
+
+  // Buildings of a cell come from its chunk and the ones before it in x and y. Walk is monotone, so chunk shared
+  // between cells is shared with one of the two previous ones.
+  glm::ivec2 tested[8];
+  std::fill(tested, tested + 8, chunkFrom - glm::ivec2(2, 2));
+  unsigned int testedCount = 0;
+  bool found = false;
+  for (float cellEntry = entry; cellEntry < distance && cellEntry <= exit;) {
+    for (const glm::ivec2& offset : {glm::ivec2(0, 0), glm::ivec2(-1, 0), glm::ivec2(0, -1), glm::ivec2(-1, -1)}) {
+      const glm::ivec2 chunk = cell + offset;
+      if (std::find(tested, tested + 8, chunk) != tested + 8) {
+        continue;
+      }
+      tested[testedCount++ % 8] = chunk;
+      if (map.chunkExists(chunk)) {
+        found |= map.getChunk(chunk).hitBuilding(origin, ray, distance, hit);
+      }
+    }
+
+    const int axis = next.x < next.y ? 0 : 1;
+    cellEntry = next[axis];
+    cell[axis] += step[axis];
+    next[axis] += delta[axis];
+  }
+  return found;
+}
+
 glm::ivec2 Geometry::pointToField(glm::vec3 point) const {
   return glm::ivec2(floor(point.x), floor(point.z));
 }
@@ -39,11 +130,6 @@ glm::ivec2 Geometry::fieldToChunk(glm::ivec2 field) const {
   return glm::ivec2(floor(chunk.x), floor(chunk.y));
 }
 
-template <typename T>
-bool Geometry::checkRectIntersection(glm::tvec2<T> a1, glm::tvec2<T> a2, glm::tvec2<T> b1, glm::tvec2<T> b2) const {
-  return !(a1.y < b2.y || a2.y > b1.y || a1.x < b2.x || a2.x > b1.x);
-}
-
 bool Geometry::checkCollisions(const data::buildings::Building& building) const {
   const glm::ivec2 a2 = glm::vec2(building.x, building.y);
   const glm::ivec2 a1 = getEnd(building);
@@ -52,23 +138,15 @@ bool Geometry::checkCollisions(const data::buildings::Building& building) const
     return true;
   }
 
-  for (data::Chunk* chunk : getWorld().getMap().getChunks()) {
+  for (const data::Chunk* chunk : getChunksAround(a2, a1)) {
     // With roads
-    for (data::Road road : chunk->getRoads()) {
-      const glm::ivec2 b2 = road.position.getGlobal();
-      const glm::ivec2 b1 = getEnd(road);
-      if (checkRectIntersection(a1, a2, b1, b2)) {
-        return true;
-      }
+    if (chunk->getRoadGraph().getRoadBounds().findFirst(a2, a1) >= 0) {
+      return true;
     }
 
     // With buildings
-    for (data::buildings::Building other : chunk->getResidentials()) {
-      const glm::ivec2 b2 = glm::vec2(other.x, other.y);
-      const glm::ivec2 b1 = getEnd(other);
-      if (checkRectIntersection(a1, a2, b1, b2)) {
-        return true;
-      }
+    if (chunk->hasBuildings(a2, a1)) {
+      return true;
     }
   }
   return false;
@@ -86,62 +164,42 @@ bool Geometry::checkCollisions(const data::Road& road) const {
   // It just works, no idea why...
 
   // With roads
-  for (const data::Road& other : chunk.getRoads()) {
-    if (checkCollisions(road, other)) {
-      return true;
-    }
+  if (checkCollisions(road, chunk)) {
+    return true;
   }
 
   // Handle roads from neighbouring chunks
   if (data::Direction::W == road.direction && 0 == road.position.getLocal().x &&
       getWorld().getMap().chunkExists(road.position.getChunk() - glm::ivec2(1, 0))) {
-    const data::Chunk& otherChunk = getWorld().getMap().getChunk(road.position.getChunk() - glm::ivec2(1, 0));
-    for (const data::Road& other : otherChunk.getRoads()) {
-      if (checkCollisions(road, other)) {
-        return true;
-      }
+    if (checkCollisions(road, getWorld().getMap().getChunk(road.position.getChunk() - glm::ivec2(1, 0)))) {
+      return true;
     }
   }
   if (data::Direction::N == road.direction && 0 == road.position.getLocal().y &&
       getWorld().getMap().chunkExists(road.position.getChunk() - glm::ivec2(0, 1))) {
-    const data::Chunk& otherChunk = getWorld().getMap().getChunk(road.position.getChunk() - glm::ivec2(0, 1));
-    for (const data::Road& other : otherChunk.getRoads()) {
-      if (checkCollisions(road, other)) {
-        return true;
-      }
-    }
-  }
-
-  // With buildings
-  const glm::ivec2 a2 = road.position.getGlobal();
-  const glm::ivec2 a1 = getEnd(road);
-  for (const data::buildings::Building& other : chunk.getResidentials()) {
-    const glm::ivec2 b2 = glm::vec2(other.x, other.y);
-    const glm::ivec2 b1 = getEnd(other);
-    if (checkRectIntersection(a1, a2, b1, b2)) {
+    if (checkCollisions(road, getWorld().getMap().getChunk(road.position.getChunk() - glm::ivec2(0, 1)))) {
       return true;
     }
   }
 
-  return false;
+  // With buildings
+  return chunk.hasBuildings(road.position.getGlobal(), getEnd(road));
 }
 
 std::vector<data::buildings::Building> Geometry::getBuildings(const glm::ivec2 from, const glm::ivec2 to) const {
   std::vector<data::buildings::Building> result;
 
-  for (data::Chunk* chunk : getWorld().getMap().getChunks()) {
-    for (data::buildings::Building building : chunk->getResidentials()) {
-      const glm::ivec2 b2 = glm::vec2(building.x, building.y);
-      const glm::ivec2 b1 = getEnd(building);
-      if (checkRectIntersection(to, from, b1, b2)) {
-        result.push_back(building);
-      }
-    }
+  for (const data::Chunk* chunk : getChunksAround(from, to)) {
+    chunk->getBuildings(from, to, result);
   }
 
   return result;
 }
 
+int64_t Geometry::getTileSum(TileQuantity quantity, const glm::ivec2 from, const glm::ivec2 to) const {
+  return getWorld().getMap().getAreaSums().getSum(quantity, from, to);
+}
+
 std::vector<data::Road> Geometry::splitRoadByChunks(const data::Road& road) const {
   std::vector<data::Road> result;
   data::Road current = road;
@@ -171,11 +229,39 @@ engine::Engine& Geometry::getEngine() const {
   return *engine;
 }
 
+std::vector<const data::Chunk*> Geometry::getChunksAround(const glm::ivec2 from, const glm::ivec2 to) const {
+  // Buildings are kept in chunk of their origin, so ones sticking into the rectangle start at most one chunk before
+  const glm::ivec2 chunkFrom = fieldToChunk(from) - glm::ivec2(1, 1);
+  const glm::ivec2 chunkTo = fieldToChunk(to);
+  std::vector<const data::Chunk*> result;
+  for (int x = chunkFrom.x; x <= chunkTo.x; x++) {
+    for (int y = chunkFrom.y; y <= chunkTo.y; y++) {
+      if (getWorld().getMap().chunkExists(glm::ivec2(x, y))) {
+        result.push_back(&getWorld().getMap().getChunk(glm::ivec2(x, y)));
+      }
+    }
+  }
+  return result;
+}
+
 bool Geometry::roadEndOutsideChunk(const data::Road& road) const {
   glm::ivec2 localEnd = getLocalEnd(road);
   return (int)data::Chunk::SIDE_LENGTH <= localEnd.x || (int)data::Chunk::SIDE_LENGTH <= localEnd.y;
 }
 
+bool Geometry::checkCollisions(const data::Road& road, const data::Chunk& chunk) const {
+  // Only roads with overlapping bounds need the exact test
+  const data::RectArray& bounds = chunk.getRoadGraph().getRoadBounds();
+  const glm::ivec2 from = road.position.getGlobal();
+  const glm::ivec2 to = getEnd(road);
+  for (int i = bounds.findFirst(from, to); i >= 0; i = bounds.findFirst(from, to, i + 1)) {
+    if (checkCollisions(road, chunk.getRoads()[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool Geometry::checkCollisions(const data::Road& road, const data::Road& other) const {
   if (!checkIntersection(road, other)) {
     return false;
@@ -223,11 +309,7 @@ bool Geometry::checkCollisions(const data::Road& road, const data::Road& other)
 }
 
 bool Geometry::checkIntersection(const data::Road& a, const data::Road& b) const {
-  const glm::ivec2 a2 = a.position.getGlobal();
-  const glm::ivec2 a1 = getEnd(a);
-  const glm::ivec2 b2 = b.position.getGlobal();
-  const glm::ivec2 b1 = getEnd(b);
-  return checkRectIntersection(a1, a2, b1, b2);
+  return data::intersects(a.position.getGlobal(), getEnd(a), b.position.getGlobal(), getEnd(b));
 }
 
 const glm::ivec2 Geometry::getEnd(const data::buildings::Building& building) const {
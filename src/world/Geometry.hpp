@@ -19,19 +19,24 @@ public:
    * @param entryPoint ray position in near field, [-1, 1]x[-1, 1]
    */
   bool hitGround(glm::vec2 entryPoint, glm::vec3& hit);
+  // Field under the cursor, buildings in front of the ground included
   bool hitField(glm::vec2 entryPoint, glm::ivec2& hit);
+  bool hitBuilding(glm::vec2 entryPoint, data::buildings::Building& hit);
+  /**
+   * @param distance limit along the ray on input, distance of the hit in ray lengths on output
+   */
+  bool hitBuilding(glm::vec3 origin, glm::vec3 ray, float& distance, data::buildings::Building& hit);
 
   glm::ivec2 pointToField(glm::vec3 point) const;
   glm::ivec2 fieldToChunk(glm::ivec2 field) const;
 
-  template <typename T>
-  bool checkRectIntersection(glm::tvec2<T> a1, glm::tvec2<T> a2, glm::tvec2<T> b1, glm::tvec2<T> b2) const;
-
   // TODO(kantoniak): Return structure with object IDs by type
   bool checkCollisions(const data::buildings::Building& building) const;
   bool checkCollisions(const data::Road& road) const;
 
   std::vector<data::buildings::Building> getBuildings(const glm::ivec2 from, const glm::ivec2 to) const;
+  // Sum of given quantity over inclusive rectangle, see AreaSums
+  int64_t getTileSum(TileQuantity quantity, const glm::ivec2 from, const glm::ivec2 to) const;
 
   std::vector<data::Road> splitRoadByChunks(const data::Road& road) const;
 
@@ -42,8 +47,11 @@ protected:
   World& getWorld() const;
   engine::Engine& getEngine() const;
 
+  // Chunks holding objects which can overlap inclusive rectangle, buildings stick out by less than chunk side
+  std::vector<const data::Chunk*> getChunksAround(const glm::ivec2 from, const glm::ivec2 to) const;
   bool roadEndOutsideChunk(const data::Road& road) const;
 
+  bool checkCollisions(const data::Road& road, const data::Chunk& chunk) const;
   bool checkCollisions(const data::Road& road, const data::Road& other) const;
   bool checkIntersection(const data::Road& a, const data::Road& b) const;
 
@@ -0,0 +1,154 @@
+#include "Isochrone.hpp"
+
+namespace world {
+
+Isochrone::Isochrone(Map& map) : map(map), currentQuery(0) {
+  rebuild();
+}
+
+void Isochrone::rebuild() {
+  network.build(map);
+
+  chunks.clear();
+  chunkIds.clear();
+  lotOffsets.clear();
+  unsigned int lotCount = 0;
+  for (const data::Chunk* chunk : map.getChunks()) {
+    chunkIds[chunk] = chunks.size();
+    chunks.push_back(chunk);
+    lotOffsets.push_back(lotCount);
+    lotCount += chunk->getLots().size();
+  }
+
+  nodes.clear();
+  nodeIds.clear();
+  for (const RoadNetwork::Node& node : network.getNodes()) {
+    const Node* graphNode = &chunks[node.chunk]->getRoadGraph().getNodes()[node.index];
+    nodeIds[graphNode] = nodes.size();
+    nodes.push_back(graphNode);
+  }
+  roads.clear();
+  for (const RoadNetwork::Road& road : network.getRoads()) {
+    roads.push_back(&chunks[road.chunk]->getRoadGraph().getRoads()[road.index]);
+  }
+
+  currentQuery = 0;
+  nodeStamps.assign(nodes.size(), 0);
+  distances.assign(nodes.size(), 0);
+  sources.assign(nodes.size(), 0);
+  roadStamps.assign(roads.size(), 0);
+  lotStamps.assign(lotCount, 0);
+}
+
+const Isochrone::Result& Isochrone::query(const Node& source, unsigned int budget) {
+  return query(std::vector<const Node*>{&source}, budget);
+}
+
+const Isochrone::Result& Isochrone::query(const std::vector<const Node*>& sources, unsigned int budget) {
+  const std::vector<uint32_t>& offsets = network.getOffsets();
+  const std::vector<RoadNetwork::Edge>& edges = network.getEdges();
+
+  startQuery();
+  for (unsigned int i = 0; i < sources.size(); i++) {
+    addSource(sources[i], i);
+  }
+
+  // Bounded Dijkstra, entries are (distance, node) in min-heap
+  const auto later = std::greater<std::pair<unsigned int, unsigned int>>();
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), later);
+    const unsigned int distance = heap.back().first;
+    const unsigned int node = heap.back().second;
+    heap.pop_back();
+    if (distance > distances[node]) {
+      continue;
+    }
+
+    for (unsigned int i = offsets[node]; i < offsets[node + 1]; i++) {
+      const RoadNetwork::Edge& edge = edges[i];
+      const unsigned int candidate = distance + edge.length;
+      if (candidate > budget) {
+        continue;
+      }
+      if (nodeStamps[edge.target] == currentQuery && distances[edge.target] <= candidate) {
+        continue;
+      }
+      if (nodeStamps[edge.target] != currentQuery) {
+        nodeStamps[edge.target] = currentQuery;
+        reached.push_back(edge.target);
+      }
+      distances[edge.target] = candidate;
+      this->sources[edge.target] = this->sources[node];
+      heap.push_back(std::make_pair(candidate, edge.target));
+      std::push_heap(heap.begin(), heap.end(), later);
+    }
+  }
+
+  collectResult();
+  return result;
+}
+
+void Isochrone::addSource(const Node* source, unsigned int index) {
+  const unsigned int node = nodeIds.at(source);
+  if (nodeStamps[node] == currentQuery) {
+    return;
+  }
+  nodeStamps[node] = currentQuery;
+  reached.push_back(node);
+  distances[node] = 0;
+  sources[node] = index;
+  heap.push_back(std::make_pair(0u, node));
+  std::push_heap(heap.begin(), heap.end(), std::greater<std::pair<unsigned int, unsigned int>>());
+}
+
+void Isochrone::startQuery() {
+  currentQuery++;
+  // Stamps wrapped around, old entries could look current
+  if (currentQuery == 0) {
+    std::fill(nodeStamps.begin(), nodeStamps.end(), 0);
+    std::fill(roadStamps.begin(), roadStamps.end(), 0);
+    std::fill(lotStamps.begin(), lotStamps.end(), 0);
+    currentQuery = 1;
+  }
+  heap.clear();
+  reached.clear();
+  result.nodes.clear();
+  result.distances.clear();
+  result.sources.clear();
+  result.roads.clear();
+  result.lots.clear();
+}
+
+void Isochrone::collectResult() {
+  for (unsigned int node : reached) {
+    result.nodes.push_back(nodes[node]);
+    result.distances.push_back(distances[node]);
+    result.sources.push_back(sources[node]);
+
+    for (unsigned int i = network.getOffsets()[node]; i < network.getOffsets()[node + 1]; i++) {
+      const unsigned int road = network.getEdges()[i].road;
+      if (road == RoadNetwork::NO_ROAD || roadStamps[road] == currentQuery) {
+        continue;
+      }
+      roadStamps[road] = currentQuery;
+      result.roads.push_back(roads[road]);
+
+      const unsigned int chunk = network.getRoads()[road].chunk;
+      const data::FrontageIndex& frontage = chunks[chunk]->getFrontageIndex();
+      for (unsigned int lot : frontage.getFrontingLots(*roads[road])) {
+        addLot(chunk, lot);
+      }
+      for (const data::FrontageIndex::BorderLot& lot : frontage.getFrontingBorderLots(*roads[road])) {
+        addLot(chunkIds.at(lot.chunk), lot.lotIndex);
+      }
+    }
+  }
+}
+
+void Isochrone::addLot(unsigned int chunk, unsigned int lot) {
+  if (lotStamps[lotOffsets[chunk] + lot] != currentQuery) {
+    lotStamps[lotOffsets[chunk] + lot] = currentQuery;
+    result.lots.push_back(LotRef{chunks[chunk], lot});
+  }
+}
+}
@@ -0,0 +1,79 @@
+#ifndef WORLD_ISOCHRONE_HPP
+#define WORLD_ISOCHRONE_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "Map.hpp"
+#include "RoadNetwork.hpp"
+
+namespace world {
+
+/**
+ * Finds parts of the road network within given travel distance, measured in tiles along roads. Keeps RoadNetwork
+ * snapshot and search buffers between queries, so call rebuild() after the map changes.
+ */
+class Isochrone {
+  typedef data::RoadGraph::Node Node;
+
+public:
+  struct LotRef {
+    const data::Chunk* chunk;
+    unsigned int index;
+  };
+
+  struct Result {
+    // Nodes in order of discovery
+    std::vector<const Node*> nodes;
+    // Distance to each node, in the same order
+    std::vector<unsigned int> distances;
+    // For multi-source queries, index of the closest source for each node
+    std::vector<unsigned int> sources;
+    // Roads with at least one end node reached
+    std::vector<const data::Road*> roads;
+    // Lots fronting reached roads
+    std::vector<LotRef> lots;
+  };
+
+  Isochrone(Map& map);
+
+  void rebuild();
+
+  const Result& query(const Node& source, unsigned int budget);
+  const Result& query(const std::vector<const Node*>& sources, unsigned int budget);
+
+protected:
+  Map& map;
+  RoadNetwork network;
+
+  std::vector<const data::Chunk*> chunks;
+  std::unordered_map<const data::Chunk*, unsigned int> chunkIds;
+  std::vector<unsigned int> lotOffsets;
+  std::vector<const Node*> nodes;
+  std::unordered_map<const Node*, unsigned int> nodeIds;
+  std::vector<const data::Road*> roads;
+
+  // Search state, valid for entries stamped with current query
+  unsigned int currentQuery;
+  std::vector<unsigned int> nodeStamps;
+  std::vector<unsigned int> distances;
+  std::vector<unsigned int> sources;
+  std::vector<unsigned int> roadStamps;
+  std::vector<unsigned int> lotStamps;
+  std::vector<std::pair<unsigned int, unsigned int>> heap;
+  std::vector<unsigned int> reached;
+  Result result;
+
+  void addSource(const Node* source, unsigned int index);
+  void startQuery();
+  void collectResult();
+  void addLot(unsigned int chunk, unsigned int lot);
+};
+}
+
+#endif
@@ -3,6 +3,9 @@
 namespace world {
 Map::Map() {
   buildingCount = 0;
+  maxBuildingSize = glm::ivec3(0, 0, 0);
+  editVersion = 0;
+  chunksVersion = 0;
 }
 
 void Map::cleanup() {
@@ -10,39 +13,59 @@ void Map::cleanup() {
     delete *it;
   }
   chunks.clear();
+  chunkIndices.clear();
+  areaSums.clear();
+  maxBuildingSize = glm::ivec3(0, 0, 0);
+  editVersion++;
+  chunksVersion++;
 }
 
 void Map::createChunk(glm::ivec2 position) {
+  createChunks({position});
+}
+
+void Map::createChunks(const std::vector<glm::ivec2>& positions) {
   // TODO(kantoniak): Check if chunk exists already
-  data::Chunk* chunk = new data::Chunk;
-  chunk->setPosition(position);
-  chunks.push_back(chunk);
+  for (const glm::ivec2& position : positions) {
+    data::Chunk* chunk = new data::Chunk;
+    chunk->setPosition(position);
+    chunksFrom = chunks.empty() ? position : glm::min(chunksFrom, position);
+    chunksTo = chunks.empty() ? position : glm::max(chunksTo, position);
+    chunkIndices[std::make_pair(position.x, position.y)] = chunks.size();
+    chunks.push_back(chunk);
+  }
+  areaSums.addChunks(positions);
+  editVersion++;
+  chunksVersion++;
 }
 
 unsigned int Map::getChunksCount() {
   return chunks.size();
 }
 
+unsigned long Map::getChunksVersion() const {
+  return chunksVersion;
+}
+
 Map::chunkList Map::getChunks() {
   return chunks;
 }
 
 const data::Chunk& Map::getChunk(glm::ivec2 chunkPosition) const {
-  for (unsigned long it = 0; it < chunks.size(); it++) {
-    if (glm::all(glm::equal(chunks[it]->getPosition(), chunkPosition))) {
-      return *(chunks[it]);
-    }
-  }
-  throw std::invalid_argument("Chunk does not exist");
+  return *(chunks[getChunkIndex(chunkPosition)]);
 }
 
 bool Map::chunkExists(glm::ivec2 chunkPosition) {
-  for (data::Chunk* chunk : getChunks()) {
-    if (glm::all(glm::equal(chunk->getPosition(), chunkPosition))) {
-      return true;
-    }
+  return chunkIndices.count(std::make_pair(chunkPosition.x, chunkPosition.y)) != 0;
+}
+
+bool Map::getChunkBounds(glm::ivec2& from, glm::ivec2& to) const {
+  if (chunks.empty()) {
+    return false;
   }
-  return false;
+  from = chunksFrom;
+  to = chunksTo;
+  return true;
 }
 
 Map::chunkListIter Map::getChunkIterator() {
@@ -50,26 +73,73 @@ Map::chunkListIter Map::getChunkIterator() {
 }
 
 bool Map::addLot(data::Lot lot) {
-  glm::ivec2 chunkPos = lot.position.getChunk();
-  if (!chunkExists(chunkPos)) {
+  if (!chunkExists(lot.position.getChunk())) {
     return false;
   }
-  getNonConstChunk(chunkPos).addLot(lot);
+  addLots({lot});
   return true;
 }
 
+void Map::addLots(const std::vector<data::Lot>& lots) {
+  // Lots can face roads of neighbours, which list them back
+  std::set<data::Chunk*> toStitch;
+  for (const data::Lot& lot : lots) {
+    const glm::ivec2 chunkPosition = lot.position.getChunk();
+    if (!chunkExists(chunkPosition)) {
+      continue;
+    }
+    data::Chunk& chunk = getNonConstChunk(chunkPosition);
+    chunk.addLot(lot);
+    toStitch.insert(&chunk);
+    for (data::Chunk* neighbour : getNeighbours(chunkPosition)) {
+      toStitch.insert(neighbour);
+    }
+  }
+  for (data::Chunk* chunk : toStitch) {
+    stitchLots(*chunk);
+  }
+  editVersion++;
+}
+
 void Map::addBuilding(data::buildings::Building building) {
   glm::ivec2 chunk = glm::ivec2(building.x, building.y) / (int)data::Chunk::SIDE_LENGTH;
   if (chunkExists(chunk)) {
     getNonConstChunk(chunk).addBuilding(building);
+    areaSums.addBuilding(building);
     buildingCount++;
+    maxBuildingSize = glm::max(maxBuildingSize, glm::ivec3(building.width, building.level, building.length));
+    editVersion++;
+  }
+}
+
+void Map::addBuildings(const std::vector<data::buildings::Building>& buildings) {
+  // Chunk is looked up again only when it changes
+  data::Chunk* chunk = nullptr;
+  glm::ivec2 chunkPosition;
+  for (const data::buildings::Building& building : buildings) {
+    const glm::ivec2 position = glm::ivec2(building.x, building.y) / (int)data::Chunk::SIDE_LENGTH;
+    if (chunk == nullptr || position != chunkPosition) {
+      chunk = chunkExists(position) ? &getNonConstChunk(position) : nullptr;
+      chunkPosition = position;
+    }
+    if (chunk != nullptr) {
+      chunk->addBuilding(building);
+      areaSums.addBuilding(building);
+      buildingCount++;
+      maxBuildingSize = glm::max(maxBuildingSize, glm::ivec3(building.width, building.level, building.length));
+    }
   }
+  editVersion++;
 }
 
 unsigned int Map::getBuildingCount() {
   return buildingCount;
 }
 
+glm::ivec3 Map::getMaxBuildingSize() const {
+  return maxBuildingSize;
+}
+
 void Map::setCurrentCity(data::City* city) {
   currentCity = city;
 }
@@ -80,29 +150,109 @@ data::City& Map::getCurrentCity() {
 }
 
 void Map::addRoad(data::Road road) {
-  getNonConstChunk(road.position.getChunk()).addRoad(road);
+  addRoads({road});
 }
 
 void Map::addRoads(std::vector<data::Road> roads) {
+  // Neighbours keep links to nodes of changed chunks, so they need stitching too
+  std::set<data::Chunk*> toStitch;
   for (auto it = roads.begin(); it != roads.end(); it++) {
-    addRoad(*it);
+    data::Chunk& chunk = getNonConstChunk(it->position.getChunk());
+    chunk.addRoad(*it);
+    toStitch.insert(&chunk);
+    for (data::Chunk* neighbour : getNeighbours(chunk.getPosition())) {
+      toStitch.insert(neighbour);
+    }
+  }
+  for (data::Chunk* chunk : toStitch) {
+    stitchRoads(*chunk);
   }
+  editVersion++;
 }
 
-void Map::removeBuilding(data::buildings::Building building) {
+void Map::buildRoads(const std::vector<data::Road>& roads) {
+  std::vector<std::vector<data::Road>> chunkRoads(chunks.size());
+  for (const data::Road& road : roads) {
+    chunkRoads[getChunkIndex(road.position.getChunk())].push_back(road);
+  }
+
+  // Graphs are independent, so workers just pick up next chunk
+  parallelFor(chunks.size(), 0, [&](unsigned long i) { chunks[i]->setRoads(chunkRoads[i]); });
+
   for (data::Chunk* chunk : chunks) {
-    if (chunk->removeBuilding(building)) {
-      buildingCount--;
+    stitchRoads(*chunk);
+  }
+  editVersion++;
+}
+
+void Map::removeBuilding(data::buildings::Building building) {
+  glm::ivec2 chunk = glm::ivec2(building.x, building.y) / (int)data::Chunk::SIDE_LENGTH;
+  if (!chunkExists(chunk)) {
+    return;
+  }
+
+  // Chunk matches buildings by position only, sums need the stored one
+  const glm::ivec2 position = glm::ivec2(building.x, building.y);
+  std::vector<data::buildings::Building> candidates;
+  getChunk(chunk).getBuildings(position, position, candidates);
+  for (const data::buildings::Building& stored : candidates) {
+    if (stored.x == building.x && stored.y == building.y) {
+      building = stored;
     }
   }
+
+  if (getNonConstChunk(chunk).removeBuilding(building)) {
+    areaSums.removeBuilding(building);
+    buildingCount--;
+    editVersion++;
+  }
+}
+
+AreaSums& Map::getAreaSums() {
+  return areaSums;
+}
+
+unsigned long Map::getEditVersion() const {
+  return editVersion;
 }
 
 data::Chunk& Map::getNonConstChunk(glm::ivec2 chunkPosition) const {
-  for (unsigned long it = 0; it < chunks.size(); it++) {
-    if (glm::all(glm::equal(chunks[it]->getPosition(), chunkPosition))) {
-      return *(chunks[it]);
+  return *(chunks[getChunkIndex(chunkPosition)]);
+}
+
+unsigned long Map::getChunkIndex(glm::ivec2 chunkPosition) const {
+  const auto it = chunkIndices.find(std::make_pair(chunkPosition.x, chunkPosition.y));
+  if (it == chunkIndices.end()) {
+    throw std::invalid_argument("Chunk does not exist");
+  }
+  return it->second;
+}
+
+std::vector<data::Chunk*> Map::getNeighbours(glm::ivec2 chunkPosition) const {
+  // In order of chunks, like the list of all chunks
+  std::vector<unsigned long> indices;
+  for (const glm::ivec2& offset : {glm::ivec2(-1, 0), glm::ivec2(1, 0), glm::ivec2(0, -1), glm::ivec2(0, 1)}) {
+    const auto it = chunkIndices.find(std::make_pair(chunkPosition.x + offset.x, chunkPosition.y + offset.y));
+    if (it != chunkIndices.end()) {
+      indices.push_back(it->second);
     }
   }
-  throw std::invalid_argument("Chunk does not exist");
+  std::sort(indices.begin(), indices.end());
+
+  std::vector<data::Chunk*> result;
+  for (unsigned long index : indices) {
+    result.push_back(chunks[index]);
+  }
+  return result;
+}
+
+void Map::stitchRoads(data::Chunk& chunk) {
+  const std::vector<data::Chunk*> neighbours = getNeighbours(chunk.getPosition());
+  chunk.stitchRoads(std::vector<const data::Chunk*>(neighbours.begin(), neighbours.end()));
+}
+
+void Map::stitchLots(data::Chunk& chunk) {
+  const std::vector<data::Chunk*> neighbours = getNeighbours(chunk.getPosition());
+  chunk.stitchLots(std::vector<const data::Chunk*>(neighbours.begin(), neighbours.end()));
 }
 }
\ No newline at end of file
@@ -1,12 +1,18 @@
 #ifndef WORLD_MAP_HPP
 #define WORLD_MAP_HPP
 
+#include <algorithm>
 #include <glm/glm.hpp>
+#include <map>
+#include <set>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
 #include "../data/Chunk.hpp"
 #include "../data/City.hpp"
+#include "AreaSums.hpp"
+#include "ParallelFor.hpp"
 
 namespace world {
 
@@ -19,17 +25,29 @@ public:
   void cleanup();
 
   void createChunk(glm::ivec2 position);
+  // Faster than creating chunks one by one
+  void createChunks(const std::vector<glm::ivec2>& positions);
 
   unsigned int getChunksCount();
+  // Changes whenever chunks are created or removed, so pointers to chunks can be cached
+  unsigned long getChunksVersion() const;
   chunkList getChunks();
   const data::Chunk& getChunk(glm::ivec2 chunkPosition) const;
   bool chunkExists(glm::ivec2 chunkPosition);
+  // Inclusive rectangle around positions of all chunks, false if there are none
+  bool getChunkBounds(glm::ivec2& from, glm::ivec2& to) const;
   chunkListIter getChunkIterator();
 
   bool addLot(data::Lot lot);
+  // Lots outside of existing chunks are skipped
+  void addLots(const std::vector<data::Lot>& lots);
 
   void addBuilding(data::buildings::Building building);
+  // Faster when buildings of the same chunk are next to each other
+  void addBuildings(const std::vector<data::buildings::Building>& buildings);
   unsigned int getBuildingCount();
+  // Largest width, level and length of buildings added since cleanup, removals do not shrink it
+  glm::ivec3 getMaxBuildingSize() const;
 
   // TODO(kantoniak): Map::setCurrentCity() - change parameter to ObjId one day
   void setCurrentCity(data::City* city);
@@ -37,17 +55,37 @@ public:
 
   void addRoad(data::Road road);
   void addRoads(std::vector<data::Road> roads);
+  /**
+   * Replaces road graphs of all chunks, one chunk per thread, then stitches them. Roads have to be split by chunks.
+   */
+  void buildRoads(const std::vector<data::Road>& roads);
 
   void removeBuilding(data::buildings::Building building);
 
+  // Changes with every edit of chunks, lots, buildings or roads, so results computed from map can be cached
+  unsigned long getEditVersion() const;
+
+  // Kept up to date with buildings
+  AreaSums& getAreaSums();
+
 protected:
   std::vector<data::Chunk*> chunks;
+  std::map<std::pair<int, int>, unsigned long> chunkIndices;
   data::City* currentCity;
+  AreaSums areaSums;
 
   // Cached
   unsigned int buildingCount;
+  glm::ivec3 maxBuildingSize;
+  glm::ivec2 chunksFrom, chunksTo;
+  unsigned long editVersion;
+  unsigned long chunksVersion;
 
   data::Chunk& getNonConstChunk(glm::ivec2 chunkPosition) const;
+  unsigned long getChunkIndex(glm::ivec2 chunkPosition) const;
+  std::vector<data::Chunk*> getNeighbours(glm::ivec2 chunkPosition) const;
+  void stitchRoads(data::Chunk& chunk);
+  void stitchLots(data::Chunk& chunk);
 };
 }
 
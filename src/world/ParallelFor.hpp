@@ -0,0 +1,49 @@
+#ifndef WORLD_PARALLELFOR_HPP
+#define WORLD_PARALLELFOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace world {
+
+/**
+ * Runs task(i) for every i in [0, count) on worker threads picking up next index, like Map::buildRoads(). First
+ * exception thrown by a task is rethrown after all workers finish.
+ *
+ * @param threadCount 0 uses all hardware threads
+ */
+template <typename F> void parallelFor(unsigned long count, unsigned int threadCount, F task) {
+  std::atomic<unsigned long> next(0);
+  std::vector<std::exception_ptr> errors(count);
+  auto worker = [&]() {
+    for (unsigned long i = next++; i < count; i = next++) {
+      try {
+        task(i);
+      } catch (...) {
+        errors[i] = std::current_exception();
+      }
+    }
+  };
+
+  const unsigned long hardware = (threadCount == 0) ? std::thread::hardware_concurrency() : threadCount;
+  const unsigned long workers = std::max(1ul, std::min(hardware, count));
+  std::vector<std::thread> threads;
+  for (unsigned long i = 1; i < workers; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  for (const std::exception_ptr& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+}
+
+#endif
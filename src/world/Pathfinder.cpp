@@ -0,0 +1,299 @@
+#include "Pathfinder.hpp"
+
+namespace world {
+
+namespace {
+constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+
+glm::ivec2 toChunk(glm::ivec2 global) {
+  return glm::ivec2(glm::floor(glm::vec2(global) / (float)SIDE));
+}
+}
+
+Pathfinder::Pathfinder(Map& map, DistanceField::SourceFunction obstacles) : map(map), obstacles(obstacles) {
+  rebuild();
+}
+
+void Pathfinder::rebuild(unsigned int threadCount) {
+  chunks = map.getChunks();
+  chunkIndices.clear();
+  glm::ivec2 minChunk = chunks.empty() ? glm::ivec2(0, 0) : chunks[0]->getPosition();
+  glm::ivec2 maxChunk = minChunk - glm::ivec2(1, 1);
+  for (unsigned long i = 0; i < chunks.size(); i++) {
+    const glm::ivec2 position = chunks[i]->getPosition();
+    chunkIndices[std::make_pair(position.x, position.y)] = i;
+    minChunk = glm::min(minChunk, position);
+    maxChunk = glm::max(maxChunk, position);
+  }
+
+  origin = minChunk * SIDE - glm::ivec2(1, 1);
+  width = (maxChunk.x - minChunk.x + 1) * SIDE + 2;
+  height = (maxChunk.y - minChunk.y + 1) * SIDE + 2;
+  blocked.assign(width * height, 1);
+  // Chunks write only their own tiles
+  parallelFor(chunks.size(), threadCount, [this](unsigned long chunk) { fillChunk(chunk); });
+}
+
+void Pathfinder::update(glm::ivec2 from, glm::ivec2 to) {
+  if (chunks.size() != map.getChunksCount()) {
+    rebuild();
+    return;
+  }
+  for (int x = toChunk(from).x; x <= toChunk(to).x; x++) {
+    for (int y = toChunk(from).y; y <= toChunk(to).y; y++) {
+      const long chunk = findChunk(glm::ivec2(x, y));
+      if (chunk >= 0) {
+        fillChunk(chunk);
+      }
+    }
+  }
+}
+
+bool Pathfinder::isFree(glm::ivec2 global) const {
+  const glm::ivec2 local = global - origin;
+  if (local.x < 0 || local.y < 0 || local.x >= width || local.y >= height) {
+    return false;
+  }
+  return isFreeLocal(local.x, local.y);
+}
+
+bool Pathfinder::findPath(glm::ivec2 from, glm::ivec2 to, Path& path) {
+  if (scratches.empty()) {
+    scratches.emplace_back(new Scratch());
+  }
+  return search(from, to, *scratches[0], path);
+}
+
+void Pathfinder::findPaths(const std::vector<Query>& queries, std::vector<Path>& paths, unsigned int threadCount) {
+  const unsigned long hardware = (threadCount == 0) ? std::thread::hardware_concurrency() : threadCount;
+  const unsigned long workers = std::max(1ul, std::min(hardware, (unsigned long)queries.size()));
+  while (scratches.size() < workers) {
+    scratches.emplace_back(new Scratch());
+  }
+
+  // Worker i takes every i-th query, so neighbouring queries of similar cost spread evenly
+  paths.resize(queries.size());
+  parallelFor(workers, workers, [&](unsigned long worker) {
+    for (unsigned long i = worker; i < queries.size(); i += workers) {
+      search(queries[i].from, queries[i].to, *scratches[worker], paths[i]);
+    }
+  });
+}
+
+long Pathfinder::findChunk(glm::ivec2 position) const {
+  const auto it = chunkIndices.find(std::make_pair(position.x, position.y));
+  return (it == chunkIndices.end()) ? -1 : (long)it->second;
+}
+
+void Pathfinder::fillChunk(unsigned long chunk) {
+  // Obstacles of neighbours can stick into this chunk
+  const glm::ivec2 position = chunks[chunk]->getPosition();
+  std::vector<DistanceField::Rect> rects;
+  for (int dx = -1; dx <= 1; dx++) {
+    for (int dy = -1; dy <= 1; dy++) {
+      const long other = findChunk(position + glm::ivec2(dx, dy));
+      if (other >= 0) {
+        obstacles(*chunks[other], rects);
+      }
+    }
+  }
+
+  const glm::ivec2 offset = position * SIDE - origin;
+  for (int y = 0; y < SIDE; y++) {
+    std::fill_n(&blocked[getTile(offset.x, offset.y + y)], SIDE, 0);
+  }
+  for (const DistanceField::Rect& rect : rects) {
+    const glm::ivec2 from = glm::max(rect.first - origin, offset);
+    const glm::ivec2 to = glm::min(rect.second - origin, offset + glm::ivec2(SIDE - 1, SIDE - 1));
+    for (int y = from.y; y <= to.y; y++) {
+      for (int x = from.x; x <= to.x; x++) {
+        blocked[getTile(x, y)] = 1;
+      }
+    }
+  }
+}
+
+bool Pathfinder::search(glm::ivec2 from, glm::ivec2 to, Scratch& scratch, Path& path) const {
+  path.found = false;
+  path.length = 0;
+  path.waypoints.clear();
+  if (!isFree(from) || !isFree(to)) {
+    return false;
+  }
+
+  if (scratch.stamps.size() != blocked.size()) {
+    scratch.stamps.assign(blocked.size(), 0);
+    scratch.costs.resize(blocked.size());
+    scratch.parents.resize(blocked.size());
+    scratch.search = 0;
+  }
+  if (++scratch.search == 0) {
+    std::fill(scratch.stamps.begin(), scratch.stamps.end(), 0);
+    scratch.search = 1;
+  }
+
+  const glm::ivec2 goal = to - origin;
+  const uint32_t start = getTile(from.x - origin.x, from.y - origin.y);
+  scratch.stamps[start] = scratch.search;
+  scratch.costs[start] = 0;
+  scratch.parents[start] = start;
+  scratch.open.clear();
+  scratch.open.push_back(std::make_pair(getOctileDistance(from, to), start));
+
+  const auto later = std::greater<std::pair<float, uint32_t>>();
+  while (!scratch.open.empty()) {
+    std::pop_heap(scratch.open.begin(), scratch.open.end(), later);
+    const float estimate = scratch.open.back().first;
+    const uint32_t tile = scratch.open.back().second;
+    scratch.open.pop_back();
+    const glm::ivec2 local = glm::ivec2(tile % width, tile / width);
+    if (estimate > scratch.costs[tile] + getOctileDistance(local, goal)) {
+      continue;
+    }
+
+    if (local == goal) {
+      path.found = true;
+      path.length = scratch.costs[tile];
+      for (uint32_t current = tile;; current = scratch.parents[current]) {
+        path.waypoints.push_back(glm::ivec2(current % width, current / width) + origin);
+        if (scratch.parents[current] == current) {
+          break;
+        }
+      }
+      std::reverse(path.waypoints.begin(), path.waypoints.end());
+      return true;
+    }
+    addNeighbours(tile, goal, scratch);
+  }
+  return false;
+}
+
+void Pathfinder::addNeighbours(uint32_t tile, glm::ivec2 goal, Scratch& scratch) const {
+  const int x = tile % width;
+  const int y = tile / width;
+  const uint32_t parent = scratch.parents[tile];
+  if (parent == tile) {
+    for (int dx = -1; dx <= 1; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        if ((dx != 0 || dy != 0) && isFreeLocal(x + dx, y) && isFreeLocal(x, y + dy)) {
+          tryJump(tile, dx, dy, goal, scratch);
+        }
+      }
+    }
+    return;
+  }
+
+  // Only neighbours which can't be reached better through the parent
+  const int dx = (x > (int)(parent % width)) - (x < (int)(parent % width));
+  const int dy = (y > (int)(parent / width)) - (y < (int)(parent / width));
+  if (dx != 0 && dy != 0) {
+    const bool horizontal = isFreeLocal(x + dx, y);
+    const bool vertical = isFreeLocal(x, y + dy);
+    if (vertical) {
+      tryJump(tile, 0, dy, goal, scratch);
+    }
+    if (horizontal) {
+      tryJump(tile, dx, 0, goal, scratch);
+    }
+    if (horizontal && vertical) {
+      tryJump(tile, dx, dy, goal, scratch);
+    }
+  } else if (dx != 0) {
+    const bool next = isFreeLocal(x + dx, y);
+    const bool up = isFreeLocal(x, y + 1);
+    const bool down = isFreeLocal(x, y - 1);
+    if (next) {
+      tryJump(tile, dx, 0, goal, scratch);
+      if (up) {
+        tryJump(tile, dx, 1, goal, scratch);
+      }
+      if (down) {
+        tryJump(tile, dx, -1, goal, scratch);
+      }
+    }
+    if (up) {
+      tryJump(tile, 0, 1, goal, scratch);
+    }
+    if (down) {
+      tryJump(tile, 0, -1, goal, scratch);
+    }
+  } else {
+    const bool next = isFreeLocal(x, y + dy);
+    const bool right = isFreeLocal(x + 1, y);
+    const bool left = isFreeLocal(x - 1, y);
+    if (next) {
+      tryJump(tile, 0, dy, goal, scratch);
+      if (right) {
+        tryJump(tile, 1, dy, goal, scratch);
+      }
+      if (left) {
+        tryJump(tile, -1, dy, goal, scratch);
+      }
+    }
+    if (right) {
+      tryJump(tile, 1, 0, goal, scratch);
+    }
+    if (left) {
+      tryJump(tile, -1, 0, goal, scratch);
+    }
+  }
+}
+
+void Pathfinder::tryJump(uint32_t tile, int dx, int dy, glm::ivec2 goal, Scratch& scratch) const {
+  const glm::ivec2 local = glm::ivec2(tile % width, tile / width);
+  const long found = jump(local.x + dx, local.y + dy, dx, dy, goal);
+  if (found < 0) {
+    return;
+  }
+
+  const uint32_t point = found;
+  const glm::ivec2 pointLocal = glm::ivec2(point % width, point / width);
+  const float cost = scratch.costs[tile] + getOctileDistance(local, pointLocal);
+  if (scratch.stamps[point] == scratch.search && scratch.costs[point] <= cost) {
+    return;
+  }
+  scratch.stamps[point] = scratch.search;
+  scratch.costs[point] = cost;
+  scratch.parents[point] = tile;
+  scratch.open.push_back(std::make_pair(cost + getOctileDistance(pointLocal, goal), point));
+  std::push_heap(scratch.open.begin(), scratch.open.end(), std::greater<std::pair<float, uint32_t>>());
+}
+
+long Pathfinder::jump(int x, int y, int dx, int dy, glm::ivec2 goal) const {
+  // Border of the grid is blocked, so walking never leaves it
+  while (true) {
+    if (!isFreeLocal(x, y)) {
+      return -1;
+    }
+    if (x == goal.x && y == goal.y) {
+      return getTile(x, y);
+    }
+
+    if (dx != 0 && dy != 0) {
+      if (jump(x + dx, y, dx, 0, goal) >= 0 || jump(x, y + dy, 0, dy, goal) >= 0) {
+        return getTile(x, y);
+      }
+      if (!isFreeLocal(x + dx, y) || !isFreeLocal(x, y + dy)) {
+        return -1;
+      }
+    } else if (dx != 0) {
+      if ((isFreeLocal(x, y - 1) && !isFreeLocal(x - dx, y - 1)) ||
+          (isFreeLocal(x, y + 1) && !isFreeLocal(x - dx, y + 1))) {
+        return getTile(x, y);
+      }
+    } else {
+      if ((isFreeLocal(x - 1, y) && !isFreeLocal(x - 1, y - dy)) ||
+          (isFreeLocal(x + 1, y) && !isFreeLocal(x + 1, y - dy))) {
+        return getTile(x, y);
+      }
+    }
+    x += dx;
+    y += dy;
+  }
+}
+
+float Pathfinder::getOctileDistance(glm::ivec2 a, glm::ivec2 b) {
+  const glm::ivec2 delta = glm::abs(a - b);
+  return std::max(delta.x, delta.y) + (std::sqrt(2.f) - 1) * std::min(delta.x, delta.y);
+}
+}
@@ -0,0 +1,109 @@
+#ifndef WORLD_PATHFINDER_HPP
+#define WORLD_PATHFINDER_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <glm/glm.hpp>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "DistanceField.hpp"
+#include "Map.hpp"
+#include "ParallelFor.hpp"
+
+namespace world {
+
+/**
+ * Shortest paths for walking agents over tiles of the map, using jump point search. Agents move to 8 neighbours
+ * but never cut corners of blocked tiles, straight steps cost 1 and diagonal ones sqrt(2). Tiles outside of chunks
+ * and tiles of obstacles are blocked; by default these are buildings, so roads can be crossed.
+ *
+ * Occupancy is a snapshot of the map, so call update() or rebuild() after edits. Search buffers are kept between
+ * queries, one set per thread of batch queries.
+ */
+class Pathfinder {
+
+public:
+  struct Query {
+    glm::ivec2 from;
+    glm::ivec2 to;
+  };
+
+  struct Path {
+    bool found;
+    float length;
+    // Global tiles from start to goal, consecutive ones are on straight or diagonal line
+    std::vector<glm::ivec2> waypoints;
+  };
+
+  Pathfinder(Map& map, DistanceField::SourceFunction obstacles = DistanceField::buildings());
+
+  /**
+   * @param threadCount 0 uses all hardware threads
+   */
+  void rebuild(unsigned int threadCount = 0);
+  // Call after obstacles within inclusive global rectangle changed
+  void update(glm::ivec2 from, glm::ivec2 to);
+
+  bool isFree(glm::ivec2 global) const;
+
+  // Reuses waypoints of given path, so it doesn't allocate once path has grown enough
+  bool findPath(glm::ivec2 from, glm::ivec2 to, Path& path);
+  /**
+   * Runs queries on worker threads, paths[i] is result of queries[i]. Existing paths are reused like in findPath().
+   *
+   * @param threadCount 0 uses all hardware threads
+   */
+  void findPaths(const std::vector<Query>& queries, std::vector<Path>& paths, unsigned int threadCount = 0);
+
+protected:
+  // Search state of single thread, valid for tiles stamped with current search
+  struct Scratch {
+    uint32_t search = 0;
+    std::vector<uint32_t> stamps;
+    std::vector<float> costs;
+    std::vector<uint32_t> parents;
+    // Min-heap of (estimate, tile)
+    std::vector<std::pair<float, uint32_t>> open;
+  };
+
+  Map& map;
+  DistanceField::SourceFunction obstacles;
+
+  std::vector<data::Chunk*> chunks;
+  std::map<std::pair<int, int>, unsigned long> chunkIndices;
+
+  // Row by row, with blocked border of one tile around bounding box of chunks
+  glm::ivec2 origin;
+  int width;
+  int height;
+  std::vector<uint8_t> blocked;
+
+  std::vector<std::unique_ptr<Scratch>> scratches;
+
+  long findChunk(glm::ivec2 position) const;
+  void fillChunk(unsigned long chunk);
+
+  inline uint32_t getTile(int x, int y) const {
+    return y * width + x;
+  }
+  inline bool isFreeLocal(int x, int y) const {
+    return !blocked[getTile(x, y)];
+  }
+
+  bool search(glm::ivec2 from, glm::ivec2 to, Scratch& scratch, Path& path) const;
+  void addNeighbours(uint32_t tile, glm::ivec2 goal, Scratch& scratch) const;
+  void tryJump(uint32_t tile, int dx, int dy, glm::ivec2 goal, Scratch& scratch) const;
+  // Tile of next jump point from (x, y) in given direction, -1 if there is none
+  long jump(int x, int y, int dx, int dy, glm::ivec2 goal) const;
+
+  static float getOctileDistance(glm::ivec2 a, glm::ivec2 b);
+};
+}
+
+#endif
@@ -0,0 +1,228 @@
+#include "RoadNetwork.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+namespace world {
+
+namespace {
+constexpr char MAGIC[4] = {'K', 'R', 'N', 'W'};
+constexpr uint32_t VERSION = 1;
+
+void write(std::ostream& out, uint32_t value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void write(std::ostream& out, int32_t value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T> T read(std::istream& in) {
+  T value;
+  if (!in.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw std::runtime_error("Road network stream ended unexpectedly");
+  }
+  return value;
+}
+
+uint32_t getDistance(glm::ivec2 from, glm::ivec2 to) {
+  const glm::ivec2 offset = glm::abs(to - from);
+  return offset.x + offset.y;
+}
+}
+
+constexpr uint32_t RoadNetwork::NO_ROAD;
+
+void RoadNetwork::build(Map& map) {
+  typedef data::RoadGraph::Node GraphNode;
+
+  nodes.clear();
+  roads.clear();
+
+  std::unordered_map<const GraphNode*, uint32_t> nodeIds;
+  const std::vector<data::Chunk*> chunks = map.getChunks();
+  for (uint32_t chunk = 0; chunk < chunks.size(); chunk++) {
+    const std::vector<GraphNode>& graphNodes = chunks[chunk]->getRoadGraph().getNodes();
+    for (uint32_t i = 0; i < graphNodes.size(); i++) {
+      nodeIds[&graphNodes[i]] = nodes.size();
+      nodes.push_back(Node{graphNodes[i].position.getGlobal(), graphNodes[i].size, chunk, i});
+    }
+  }
+
+  std::vector<std::vector<Edge>> adjacency(nodes.size());
+  auto addEdges = [&](const GraphNode* from, const GraphNode* to, uint32_t type, uint32_t road) {
+    const uint32_t a = nodeIds.at(from);
+    const uint32_t b = nodeIds.at(to);
+    const uint32_t length = getDistance(from->position.getGlobal(), to->position.getGlobal());
+    adjacency[a].push_back(Edge{b, length, type, road});
+    adjacency[b].push_back(Edge{a, length, type, road});
+  };
+
+  for (uint32_t chunk = 0; chunk < chunks.size(); chunk++) {
+    const data::RoadGraph& graph = chunks[chunk]->getRoadGraph();
+    const data::Road* first = graph.getRoads().data();
+    std::vector<const GraphNode*> starts(graph.getRoads().size(), nullptr);
+    std::vector<const GraphNode*> ends(graph.getRoads().size(), nullptr);
+    for (const GraphNode& node : graph.getNodes()) {
+      if (node.N != nullptr) {
+        starts[node.N - first] = &node;
+      }
+      if (node.W != nullptr) {
+        starts[node.W - first] = &node;
+      }
+      if (node.S != nullptr) {
+        ends[node.S - first] = &node;
+      }
+      if (node.E != nullptr) {
+        ends[node.E - first] = &node;
+      }
+      // Stitches are added from south and east side only, so each of them once
+      if (node.nextN != nullptr) {
+        addEdges(&node, node.nextN, node.S->getType().id, NO_ROAD);
+      }
+      if (node.nextW != nullptr) {
+        addEdges(&node, node.nextW, node.E->getType().id, NO_ROAD);
+      }
+    }
+
+    for (uint32_t i = 0; i < graph.getRoads().size(); i++) {
+      const data::Road& road = graph.getRoads()[i];
+      if (starts[i] == nullptr || ends[i] == nullptr) {
+        continue;
+      }
+      const uint32_t id = roads.size();
+      roads.push_back(Road{nodeIds.at(starts[i]), nodeIds.at(ends[i]), road.length, road.getType().id, chunk, i});
+      addEdges(starts[i], ends[i], road.getType().id, id);
+    }
+  }
+
+  offsets.assign(1, 0);
+  edges.clear();
+  for (const std::vector<Edge>& nodeEdges : adjacency) {
+    edges.insert(edges.end(), nodeEdges.begin(), nodeEdges.end());
+    offsets.push_back(edges.size());
+  }
+}
+
+void RoadNetwork::dump(std::ostream& out) const {
+  out.write(MAGIC, sizeof(MAGIC));
+  write(out, VERSION);
+  write(out, (uint32_t)nodes.size());
+  write(out, (uint32_t)roads.size());
+  write(out, (uint32_t)edges.size());
+
+  for (const Node& node : nodes) {
+    write(out, (int32_t)node.position.x);
+    write(out, (int32_t)node.position.y);
+    write(out, (int32_t)node.size.x);
+    write(out, (int32_t)node.size.y);
+    write(out, node.chunk);
+    write(out, node.index);
+  }
+  for (const Road& road : roads) {
+    write(out, road.from);
+    write(out, road.to);
+    write(out, road.length);
+    write(out, road.type);
+    write(out, road.chunk);
+    write(out, road.index);
+  }
+  for (uint32_t offset : offsets) {
+    write(out, offset);
+  }
+  for (const Edge& edge : edges) {
+    write(out, edge.target);
+    write(out, edge.length);
+    write(out, edge.type);
+    write(out, edge.road);
+  }
+
+  if (!out) {
+    throw std::runtime_error("Could not write road network");
+  }
+}
+
+void RoadNetwork::load(std::istream& in) {
+  char magic[sizeof(MAGIC)];
+  if (!in.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), MAGIC)) {
+    throw std::runtime_error("Stream does not contain road network");
+  }
+  if (read<uint32_t>(in) != VERSION) {
+    throw std::runtime_error("Unsupported road network version");
+  }
+
+  // Counts are not trusted, so vectors grow only as data is actually read
+  RoadNetwork loaded;
+  const uint32_t nodesCount = read<uint32_t>(in);
+  const uint32_t roadsCount = read<uint32_t>(in);
+  const uint32_t edgesCount = read<uint32_t>(in);
+
+  for (uint32_t i = 0; i < nodesCount; i++) {
+    Node node;
+    node.position.x = read<int32_t>(in);
+    node.position.y = read<int32_t>(in);
+    node.size.x = read<int32_t>(in);
+    node.size.y = read<int32_t>(in);
+    node.chunk = read<uint32_t>(in);
+    node.index = read<uint32_t>(in);
+    loaded.nodes.push_back(node);
+  }
+  for (uint32_t i = 0; i < roadsCount; i++) {
+    Road road;
+    road.from = read<uint32_t>(in);
+    road.to = read<uint32_t>(in);
+    road.length = read<uint32_t>(in);
+    road.type = read<uint32_t>(in);
+    road.chunk = read<uint32_t>(in);
+    road.index = read<uint32_t>(in);
+    loaded.roads.push_back(road);
+  }
+  for (uint32_t i = 0; i <= nodesCount; i++) {
+    loaded.offsets.push_back(read<uint32_t>(in));
+  }
+  for (uint32_t i = 0; i < edgesCount; i++) {
+    Edge edge;
+    edge.target = read<uint32_t>(in);
+    edge.length = read<uint32_t>(in);
+    edge.type = read<uint32_t>(in);
+    edge.road = read<uint32_t>(in);
+    loaded.edges.push_back(edge);
+  }
+
+  loaded.validate();
+  *this = std::move(loaded);
+}
+
+const std::vector<RoadNetwork::Node>& RoadNetwork::getNodes() const {
+  return nodes;
+}
+
+const std::vector<RoadNetwork::Road>& RoadNetwork::getRoads() const {
+  return roads;
+}
+
+const std::vector<uint32_t>& RoadNetwork::getOffsets() const {
+  return offsets;
+}
+
+const std::vector<RoadNetwork::Edge>& RoadNetwork::getEdges() const {
+  return edges;
+}
+
+void RoadNetwork::validate() const {
+  if (offsets.front() != 0 || offsets.back() != edges.size() || !std::is_sorted(offsets.begin(), offsets.end())) {
+    throw std::runtime_error("Road network has invalid edge offsets");
+  }
+  for (const Edge& edge : edges) {
+    if (edge.target >= nodes.size() || (edge.road != NO_ROAD && edge.road >= roads.size())) {
+      throw std::runtime_error("Road network edge points outside of the network");
+    }
+  }
+  for (const Road& road : roads) {
+    if (road.from >= nodes.size() || road.to >= nodes.size()) {
+      throw std::runtime_error("Road network road points outside of the network");
+    }
+  }
+}
+}
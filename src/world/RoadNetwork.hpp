@@ -0,0 +1,76 @@
+#ifndef WORLD_ROADNETWORK_HPP
+#define WORLD_ROADNETWORK_HPP
+
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "Map.hpp"
+
+namespace world {
+
+/**
+ * Flat snapshot of the road network of the whole map in compressed sparse row form: edges of node i are
+ * edges[offsets[i]] to edges[offsets[i + 1] - 1]. Every road segment gives two edges, one per direction, and so does
+ * every stitch between nodes on both sides of chunk border.
+ *
+ * Snapshot does not follow changes of the map. It can be dumped to and loaded from binary stream, stored in native
+ * byte order.
+ */
+class RoadNetwork {
+
+public:
+  static constexpr uint32_t NO_ROAD = std::numeric_limits<uint32_t>::max();
+
+  struct Node {
+    glm::ivec2 position;
+    glm::ivec2 size;
+    // Source node in the map
+    uint32_t chunk;
+    uint32_t index;
+  };
+
+  struct Road {
+    uint32_t from;
+    uint32_t to;
+    uint32_t length;
+    uint32_t type;
+    // Source road in the map
+    uint32_t chunk;
+    uint32_t index;
+  };
+
+  struct Edge {
+    uint32_t target;
+    // Distance between nodes in tiles
+    uint32_t length;
+    uint32_t type;
+    // Road the edge runs along, NO_ROAD for stitches
+    uint32_t road;
+  };
+
+  void build(Map& map);
+
+  void dump(std::ostream& out) const;
+  void load(std::istream& in);
+
+  const std::vector<Node>& getNodes() const;
+  const std::vector<Road>& getRoads() const;
+  const std::vector<uint32_t>& getOffsets() const;
+  const std::vector<Edge>& getEdges() const;
+
+protected:
+  std::vector<Node> nodes;
+  std::vector<Road> roads;
+  std::vector<uint32_t> offsets;
+  std::vector<Edge> edges;
+
+  void validate() const;
+};
+}
+
+#endif
@@ -0,0 +1,152 @@
+#include "ScenarioGenerator.hpp"
+
+namespace world {
+
+namespace {
+constexpr int SIDE = data::Chunk::SIDE_LENGTH;
+// Blocks of lots when there are no roads
+constexpr unsigned int DEFAULT_BLOCK_SIDE = 16;
+}
+
+constexpr unsigned int ScenarioGenerator::MAX_SIDE;
+constexpr unsigned int ScenarioGenerator::MAX_BUILDING_HEIGHT;
+
+ScenarioGenerator::ScenarioGenerator(unsigned int seed, const settings::Scenario& scenario)
+    : seed(seed), scenario(scenario) {
+  clampToLimits(this->scenario);
+}
+
+bool ScenarioGenerator::getPreset(const std::string& name, settings::Scenario& scenario) {
+  if (name == "1k") {
+    scenario.width = scenario.height = 32;
+  } else if (name == "10k") {
+    scenario.width = scenario.height = 100;
+  } else if (name == "100k") {
+    scenario.width = scenario.height = 316;
+  } else {
+    return false;
+  }
+  scenario.roadSpacing = 16;
+  scenario.lotDensity = 0.5f;
+  scenario.buildingsPerChunk = 40;
+  scenario.minBuildingHeight = 1;
+  scenario.maxBuildingHeight = 20;
+  scenario.heightDistribution = HeightDistribution::DOWNTOWN;
+  return true;
+}
+
+bool ScenarioGenerator::getHeightDistribution(const std::string& name, HeightDistribution& distribution) {
+  if (name == "uniform") {
+    distribution = HeightDistribution::UNIFORM;
+  } else if (name == "skewed") {
+    distribution = HeightDistribution::SKEWED;
+  } else if (name == "downtown") {
+    distribution = HeightDistribution::DOWNTOWN;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool ScenarioGenerator::clampToLimits(settings::Scenario& scenario) {
+  const settings::Scenario original = scenario;
+  scenario.width = std::min(scenario.width, MAX_SIDE);
+  scenario.height = std::min(scenario.height, MAX_SIDE);
+  scenario.minBuildingHeight = std::min(scenario.minBuildingHeight, MAX_BUILDING_HEIGHT);
+  scenario.maxBuildingHeight = std::min(scenario.maxBuildingHeight, MAX_BUILDING_HEIGHT);
+  return original.width == scenario.width && original.height == scenario.height &&
+         original.minBuildingHeight == scenario.minBuildingHeight &&
+         original.maxBuildingHeight == scenario.maxBuildingHeight;
+}
+
+void ScenarioGenerator::generate(Map& map, unsigned int threadCount) const {
+  map.createChunks(getChunkPositions());
+  map.buildRoads(generateRoads());
+  map.addLots(generateLots());
+
+  WorldGenerator::Settings settings;
+  settings.buildingsPerChunk = scenario.buildingsPerChunk;
+  settings.minBuildingHeight = scenario.minBuildingHeight;
+  settings.maxBuildingHeightDifference =
+      std::max(scenario.minBuildingHeight, scenario.maxBuildingHeight) - scenario.minBuildingHeight + 1;
+  settings.heightDistribution = scenario.heightDistribution;
+  WorldGenerator(seed, settings).populate(map, threadCount);
+}
+
+std::vector<glm::ivec2> ScenarioGenerator::getChunkPositions() const {
+  std::vector<glm::ivec2> result;
+  for (unsigned int x = 0; x < scenario.width; x++) {
+    for (unsigned int y = 0; y < scenario.height; y++) {
+      result.push_back(glm::ivec2(x, y));
+    }
+  }
+  return result;
+}
+
+std::vector<data::Road> ScenarioGenerator::generateRoads() const {
+  std::vector<data::Road> result;
+  const unsigned int spacing = getRoadSpacing();
+  if (spacing == 0) {
+    return result;
+  }
+
+  // Every road spans single chunk, so the grid is split by chunks already
+  const glm::ivec2 tiles = glm::ivec2(scenario.width, scenario.height) * SIDE;
+  const int width = data::RoadTypes.Standard.width;
+  data::Road road;
+  road.setType(data::RoadTypes.Standard);
+  road.length = SIDE;
+  for (int y = 0; y + width <= tiles.y; y += spacing) {
+    for (int x = 0; x < tiles.x; x += SIDE) {
+      road.position.setGlobal(glm::ivec2(x, y));
+      road.direction = data::Direction::W;
+      result.push_back(road);
+    }
+  }
+  for (int x = 0; x + width <= tiles.x; x += spacing) {
+    for (int y = 0; y < tiles.y; y += SIDE) {
+      road.position.setGlobal(glm::ivec2(x, y));
+      road.direction = data::Direction::N;
+      result.push_back(road);
+    }
+  }
+  return result;
+}
+
+std::vector<data::Lot> ScenarioGenerator::generateLots() const {
+  std::vector<data::Lot> result;
+  const unsigned int spacing = getRoadSpacing();
+  const int blockSide = (spacing == 0) ? DEFAULT_BLOCK_SIDE : spacing;
+  const int margin = (spacing == 0) ? 0 : data::RoadTypes.Standard.width;
+  const glm::ivec2 tiles = glm::ivec2(scenario.width, scenario.height) * SIDE;
+
+  // Lots take front half of the block, facing the road before it
+  for (const glm::ivec2& chunk : getChunkPositions()) {
+    engine::Random::Stream random = engine::Random(seed).getStream(engine::RandomSystem::SCENARIO, chunk);
+    const glm::ivec2 firstBlock = (chunk * SIDE + glm::ivec2(blockSide - 1)) / blockSide * blockSide;
+    for (int x = firstBlock.x; x < (chunk.x + 1) * SIDE; x += blockSide) {
+      for (int y = firstBlock.y; y < (chunk.y + 1) * SIDE; y += blockSide) {
+        const glm::ivec2 from = glm::ivec2(x, y) + margin;
+        const glm::ivec2 to = glm::min(glm::ivec2(x, y) + blockSide - 1, tiles - 1);
+        if (random.nextFloat() >= scenario.lotDensity || to.x < from.x || to.y < from.y) {
+          continue;
+        }
+        data::Lot lot;
+        lot.objectId = 0;
+        lot.position.setGlobal(from);
+        lot.direction = data::Direction::S;
+        lot.size = glm::ivec2(to.x - from.x + 1, std::max(1, (to.y - from.y + 1) / 2));
+        result.push_back(lot);
+      }
+    }
+  }
+  return result;
+}
+
+unsigned int ScenarioGenerator::getRoadSpacing() const {
+  if (scenario.roadSpacing == 0) {
+    return 0;
+  }
+  return std::max(scenario.roadSpacing, (unsigned int)data::RoadTypes.Standard.width + 1);
+}
+}
@@ -0,0 +1,60 @@
+#ifndef WORLD_SCENARIOGENERATOR_HPP
+#define WORLD_SCENARIOGENERATOR_HPP
+
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "../data/Lot.hpp"
+#include "../data/Road.hpp"
+#include "../engine/Random.hpp"
+#include "Map.hpp"
+#include "WorldGenerator.hpp"
+#include "settings.hpp"
+
+namespace world {
+
+/**
+ * Builds whole cities of given size for stress testing: chunks, grid of roads, lots in blocks between roads and
+ * buildings from WorldGenerator. The same seed and scenario always give the same city.
+ */
+class ScenarioGenerator {
+
+public:
+  // Largest scenario renderer can draw, it keeps building positions in int16 and levels in uint8
+  constexpr static unsigned int MAX_SIDE = 512;
+  constexpr static unsigned int MAX_BUILDING_HEIGHT = 255;
+
+  ScenarioGenerator(unsigned int seed, const settings::Scenario& scenario);
+
+  // Presets "1k", "10k" and "100k" with about that many chunks, false for unknown name
+  static bool getPreset(const std::string& name, settings::Scenario& scenario);
+  // "uniform", "skewed" or "downtown", false for unknown name
+  static bool getHeightDistribution(const std::string& name, HeightDistribution& distribution);
+  // Clamps size and building heights to limits above, false if scenario had to change
+  static bool clampToLimits(settings::Scenario& scenario);
+
+  /**
+   * Fills empty map with the scenario.
+   *
+   * @param threadCount 0 uses all hardware threads
+   */
+  void generate(Map& map, unsigned int threadCount = 0) const;
+
+  std::vector<glm::ivec2> getChunkPositions() const;
+  // Split by chunks, as needed by Map::buildRoads()
+  std::vector<data::Road> generateRoads() const;
+  std::vector<data::Lot> generateLots() const;
+
+protected:
+  unsigned int seed;
+  settings::Scenario scenario;
+
+  // Parallel roads have to leave at least one free tile between them
+  unsigned int getRoadSpacing() const;
+};
+}
+
+#endif
@@ -0,0 +1,160 @@
+#include "VisibleRegion.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace world {
+
+namespace {
+float cross(glm::vec2 origin, glm::vec2 a, glm::vec2 b) {
+  return (a.x - origin.x) * (b.y - origin.y) - (a.y - origin.y) * (b.x - origin.x);
+}
+
+// Counter-clockwise convex hull, footprint cut at far plane is not always convex
+std::vector<glm::vec2> getHull(std::vector<glm::vec2> points) {
+  std::sort(points.begin(), points.end(),
+            [](glm::vec2 a, glm::vec2 b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+  std::vector<glm::vec2> hull(2 * points.size());
+  unsigned long size = 0;
+  for (unsigned long i = 0; i < points.size(); i++) {
+    while (size >= 2 && cross(hull[size - 2], hull[size - 1], points[i]) <= 0) {
+      size--;
+    }
+    hull[size++] = points[i];
+  }
+  for (unsigned long i = points.size() - 1, lower = size + 1; i-- > 0;) {
+    while (size >= lower && cross(hull[size - 2], hull[size - 1], points[i]) <= 0) {
+      size--;
+    }
+    hull[size++] = points[i];
+  }
+  hull.resize(size > 1 ? size - 1 : size);
+  return hull;
+}
+}
+
+VisibleRegion::VisibleRegion(Map& map, Camera& camera) : map(map), camera(camera) {}
+
+bool VisibleRegion::update() {
+  if (computed && cameraVersion == camera.getVersion() && chunksVersion == map.getChunksVersion() &&
+      maxBuildingSize == map.getMaxBuildingSize()) {
+    return false;
+  }
+  maxBuildingSize = map.getMaxBuildingSize();
+  compute();
+  computed = true;
+  cameraVersion = camera.getVersion();
+  chunksVersion = map.getChunksVersion();
+  version++;
+  return true;
+}
+
+unsigned long VisibleRegion::getVersion() const {
+  return version;
+}
+
+const std::array<glm::vec2, 4>& VisibleRegion::getFootprint() const {
+  return footprint;
+}
+
+glm::ivec2 VisibleRegion::getFrom() const {
+  return from;
+}
+
+glm::ivec2 VisibleRegion::getTo() const {
+  return to;
+}
+
+const std::vector<data::Chunk*>& VisibleRegion::getChunks() const {
+  return chunks;
+}
+
+const std::vector<unsigned int>& VisibleRegion::getChunkIndices() const {
+  return chunkIndices;
+}
+
+bool VisibleRegion::containsChunk(glm::ivec2 chunkPosition) const {
+  return chunkPositions.count(std::make_pair(chunkPosition.x, chunkPosition.y)) > 0;
+}
+
+void VisibleRegion::compute() {
+  // Position has to go first, it refreshes matrices used by rays
+  const glm::vec3 origin = camera.getPosition();
+  const glm::vec2 corners[] = {glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(1, 1), glm::vec2(-1, 1)};
+  const float height = maxBuildingSize.y;
+  std::vector<glm::vec2> points;
+  for (unsigned int i = 0; i < footprint.size(); i++) {
+    const glm::vec3 ray = camera.getRay(corners[i]);
+    footprint[i] = hitPlane(origin, ray, 0, camera.getZFar());
+    points.push_back(footprint[i]);
+    // Buildings can be seen along the part of the ray below their tops
+    if (height > 0) {
+      points.push_back(hitPlane(origin, ray, height, camera.getZFar()));
+    }
+  }
+  if (origin.y < height) {
+    points.push_back(glm::vec2(origin.x, origin.z));
+  }
+
+  glm::vec2 min = glm::vec2(INFINITY, INFINITY);
+  glm::vec2 max = -min;
+  for (const glm::vec2& point : points) {
+    min = glm::min(min, point);
+    max = glm::max(max, point);
+  }
+  from = glm::ivec2(glm::floor(min));
+  to = glm::ivec2(glm::floor(max));
+  hull = getHull(points);
+
+  chunks.clear();
+  chunkIndices.clear();
+  chunkPositions.clear();
+  // Buildings are kept in chunk of their origin and can stick out of it
+  const float side = data::Chunk::SIDE_LENGTH;
+  const glm::vec2 reach = glm::vec2(maxBuildingSize.x, maxBuildingSize.z);
+  const std::vector<data::Chunk*> mapChunks = map.getChunks();
+  for (unsigned int i = 0; i < mapChunks.size(); i++) {
+    data::Chunk* chunk = mapChunks[i];
+    const glm::vec2 chunkMin = glm::vec2(chunk->getPosition()) * side;
+    if (overlaps(chunkMin, chunkMin + glm::vec2(side, side) + reach)) {
+      chunks.push_back(chunk);
+      chunkIndices.push_back(i);
+      chunkPositions.insert(std::make_pair(chunk->getPosition().x, chunk->getPosition().y));
+    }
+  }
+}
+
+glm::vec2 VisibleRegion::hitPlane(glm::vec3 origin, glm::vec3 ray, float height, float maxDistance) const {
+  const glm::vec2 ground = glm::vec2(origin.x, origin.z);
+  const float distance = (height - origin.y) / ray.y;
+  if (ray.y != 0 && 0 <= distance && distance <= maxDistance) {
+    const glm::vec3 hit = origin + distance * ray;
+    return glm::vec2(hit.x, hit.z);
+  }
+  // Towards the horizon, the furthest ground point under the ray
+  const glm::vec2 direction = glm::vec2(ray.x, ray.z);
+  const float length = glm::length(direction);
+  return (length > 0) ? ground + direction * (maxDistance / length) : ground;
+}
+
+bool VisibleRegion::overlaps(glm::vec2 min, glm::vec2 max) const {
+  if (max.x < from.x || max.y < from.y || min.x > to.x + 1 || min.y > to.y + 1) {
+    return false;
+  }
+
+  // Box is separated from convex hull if all its corners lie outside one of hull edges
+  const glm::vec2 boxCorners[] = {min, glm::vec2(max.x, min.y), max, glm::vec2(min.x, max.y)};
+  for (unsigned long i = 0; i < hull.size(); i++) {
+    const glm::vec2 a = hull[i];
+    const glm::vec2 b = hull[(i + 1) % hull.size()];
+    bool outside = true;
+    for (const glm::vec2& corner : boxCorners) {
+      outside &= cross(a, b, corner) < 0;
+    }
+    if (outside) {
+      return false;
+    }
+  }
+  return true;
+}
+}
@@ -0,0 +1,67 @@
+#ifndef WORLD_VISIBLEREGION_HPP
+#define WORLD_VISIBLEREGION_HPP
+
+#include <array>
+#include <glm/glm.hpp>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "Camera.hpp"
+#include "Map.hpp"
+
+namespace world {
+
+/**
+ * Part of the ground seen by the camera and chunks lying on it, or having buildings tall enough to be seen. Computed
+ * from corner rays of the screen once per camera change, so rendering, paging and simulation can all share it.
+ */
+class VisibleRegion {
+
+public:
+  VisibleRegion(Map& map, Camera& camera);
+
+  // Recomputes only when camera, set of chunks or largest building changed since last call, returns true if it did
+  bool update();
+  // Changes with every recomputation
+  unsigned long getVersion() const;
+
+  // Ground hits of rays through screen corners, in order around the screen. Rays above the horizon are cut at far
+  // plane distance.
+  const std::array<glm::vec2, 4>& getFootprint() const;
+  // Inclusive tile rectangle around footprint and parts of rays passing by buildings
+  glm::ivec2 getFrom() const;
+  glm::ivec2 getTo() const;
+
+  // Chunks overlapping footprint or with buildings which can be seen, in order of Map::getChunks()
+  const std::vector<data::Chunk*>& getChunks() const;
+  // Index of each of these chunks in Map::getChunks()
+  const std::vector<unsigned int>& getChunkIndices() const;
+  bool containsChunk(glm::ivec2 chunkPosition) const;
+
+protected:
+  Map& map;
+  Camera& camera;
+
+  bool computed = false;
+  unsigned long cameraVersion = 0;
+  unsigned long chunksVersion = 0;
+  glm::ivec3 maxBuildingSize = glm::ivec3(0, 0, 0);
+  unsigned long version = 0;
+
+  std::array<glm::vec2, 4> footprint;
+  std::vector<glm::vec2> hull;
+  glm::ivec2 from, to;
+  std::vector<data::Chunk*> chunks;
+  std::vector<unsigned int> chunkIndices;
+  std::set<std::pair<int, int>> chunkPositions;
+
+  void compute();
+  // Where ray crosses horizontal plane at given height
+  glm::vec2 hitPlane(glm::vec3 origin, glm::vec3 ray, float height, float maxDistance) const;
+  bool overlaps(glm::vec2 min, glm::vec2 max) const;
+};
+}
+
+#endif
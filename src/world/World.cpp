@@ -24,4 +24,9 @@ Map& World::getMap() {
 Timer& World::getTimer() {
   return timer;
 }
+
+const VisibleRegion& World::getVisibleRegion() {
+  visibleRegion.update();
+  return visibleRegion;
+}
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "Camera.hpp"
 #include "Map.hpp"
 #include "Timer.hpp"
+#include "VisibleRegion.hpp"
 
 namespace world {
 
@@ -18,11 +19,14 @@ public:
   Camera& getCamera();
   Map& getMap();
   Timer& getTimer();
+  // Brought up to date with the camera on every call
+  const VisibleRegion& getVisibleRegion();
 
 protected:
   Camera camera;
   Map map;
   Timer timer;
+  VisibleRegion visibleRegion{map, camera};
 };
 }
 
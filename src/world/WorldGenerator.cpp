@@ -0,0 +1,159 @@
+#include "WorldGenerator.hpp"
+
+namespace world {
+
+namespace {
+const glm::ivec2 NEIGHBOURS[] = {glm::ivec2(-1, -1), glm::ivec2(0, -1), glm::ivec2(1, -1), glm::ivec2(-1, 0),
+                                 glm::ivec2(1, 0),   glm::ivec2(-1, 1), glm::ivec2(0, 1),  glm::ivec2(1, 1)};
+
+bool isLower(glm::ivec2 a, glm::ivec2 b) {
+  return a.x < b.x || (a.x == b.x && a.y < b.y);
+}
+}
+
+WorldGenerator::WorldGenerator(unsigned int seed) : seed(seed) {}
+
+WorldGenerator::WorldGenerator(unsigned int seed, const Settings& settings) : seed(seed), settings(settings) {}
+
+std::vector<data::buildings::Building> WorldGenerator::generateBuildings(Map& map, unsigned int threadCount) const {
+  Layout layout;
+  layout.chunks = map.getChunks();
+  glm::ivec2 minChunk = layout.chunks.empty() ? glm::ivec2(0, 0) : layout.chunks[0]->getPosition();
+  glm::ivec2 maxChunk = minChunk;
+  for (unsigned long i = 0; i < layout.chunks.size(); i++) {
+    const glm::ivec2 position = layout.chunks[i]->getPosition();
+    layout.indices[std::make_pair(position.x, position.y)] = i;
+    minChunk = glm::min(minChunk, position);
+    maxChunk = glm::max(maxChunk, position);
+  }
+  layout.center = glm::vec2(minChunk + maxChunk) / 2.f;
+  layout.radius = glm::length(glm::vec2(maxChunk - minChunk) / 2.f);
+
+  // Candidates only read the map, so chunks can be processed in any order
+  std::vector<std::vector<data::buildings::Building>> candidates(layout.chunks.size());
+  parallelFor(layout.chunks.size(), threadCount,
+              [&](unsigned long chunk) { candidates[chunk] = generateCandidates(layout, chunk); });
+
+  std::vector<std::vector<data::buildings::Building>> accepted(layout.chunks.size());
+  parallelFor(layout.chunks.size(), threadCount, [&](unsigned long chunk) {
+    for (const data::buildings::Building& building : candidates[chunk]) {
+      if (!hasBorderConflict(building, layout, chunk, candidates)) {
+        accepted[chunk].push_back(building);
+      }
+    }
+  });
+
+  std::vector<data::buildings::Building> result;
+  for (const std::vector<data::buildings::Building>& buildings : accepted) {
+    result.insert(result.end(), buildings.begin(), buildings.end());
+  }
+  return result;
+}
+
+void WorldGenerator::populate(Map& map, unsigned int threadCount) const {
+  map.addBuildings(generateBuildings(map, threadCount));
+}
+
+long WorldGenerator::Layout::find(glm::ivec2 position) const {
+  const auto it = indices.find(std::make_pair(position.x, position.y));
+  return (it == indices.end()) ? -1 : (long)it->second;
+}
+
+std::vector<data::buildings::Building> WorldGenerator::generateCandidates(const Layout& layout,
+                                                                          unsigned long chunk) const {
+  const glm::ivec2 position = layout.chunks[chunk]->getPosition();
+  engine::Random::Stream random = engine::Random(seed).getStream(engine::RandomSystem::WORLD_GENERATOR, position);
+
+  const glm::ivec2 origin = position * (int)data::Chunk::SIDE_LENGTH;
+  const float centrality =
+      (layout.radius > 0) ? 1 - glm::length(glm::vec2(position) - layout.center) / layout.radius : 1;
+  std::vector<data::buildings::Building> result;
+  for (unsigned int i = 0; i < settings.buildingsPerChunk; i++) {
+    for (unsigned int j = 0; j < settings.maxCollisionTries; j++) {
+      data::buildings::Building building;
+      building.objectId = 0;
+      building.width = random.nextBelow(settings.maxBuildingSideDifference) + settings.minBuildingSide;
+      building.length = random.nextBelow(settings.maxBuildingSideDifference) + settings.minBuildingSide;
+      building.level = getLevel(random, centrality);
+      building.x = origin.x + random.nextBelow(data::Chunk::SIDE_LENGTH);
+      building.y = origin.y + random.nextBelow(data::Chunk::SIDE_LENGTH);
+
+      const bool overlapsCandidate =
+          std::any_of(result.begin(), result.end(), [&](const data::buildings::Building& other) {
+            return data::intersects(glm::ivec2(building.x, building.y), getEnd(building),
+                                    glm::ivec2(other.x, other.y), getEnd(other));
+          });
+      if (!overlapsCandidate && isFree(building, layout, chunk)) {
+        result.push_back(building);
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+unsigned short WorldGenerator::getLevel(engine::Random::Stream& random, float centrality) const {
+  switch (settings.heightDistribution) {
+  case HeightDistribution::SKEWED: {
+    const float value = random.nextFloat();
+    return value * value * settings.maxBuildingHeightDifference + settings.minBuildingHeight;
+  }
+  case HeightDistribution::DOWNTOWN: {
+    const unsigned int difference = std::max(1.f, std::round(centrality * settings.maxBuildingHeightDifference));
+    return random.nextBelow(difference) + settings.minBuildingHeight;
+  }
+  default:
+    return random.nextBelow(settings.maxBuildingHeightDifference) + settings.minBuildingHeight;
+  }
+}
+
+bool WorldGenerator::isFree(const data::buildings::Building& building, const Layout& layout,
+                            unsigned long chunk) const {
+  const glm::ivec2 from = glm::ivec2(building.x, building.y);
+  const glm::ivec2 to = getEnd(building);
+  const glm::ivec2 position = layout.chunks[chunk]->getPosition();
+  // Whole building has to be on the map
+  if (layout.find(to / (int)data::Chunk::SIDE_LENGTH) < 0) {
+    return false;
+  }
+
+  // Roads and buildings of neighbouring chunks can stick into this one
+  for (int dx = -1; dx <= 1; dx++) {
+    for (int dy = -1; dy <= 1; dy++) {
+      const long other = layout.find(position + glm::ivec2(dx, dy));
+      if (other < 0) {
+        continue;
+      }
+      const data::Chunk& otherChunk = *layout.chunks[other];
+      if (otherChunk.getRoadGraph().getRoadBounds().findFirst(from, to) >= 0 || otherChunk.hasBuildings(from, to)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool WorldGenerator::hasBorderConflict(const data::buildings::Building& building, const Layout& layout,
+                                       unsigned long chunk,
+                                       const std::vector<std::vector<data::buildings::Building>>& candidates) const {
+  const glm::ivec2 from = glm::ivec2(building.x, building.y);
+  const glm::ivec2 to = getEnd(building);
+  const glm::ivec2 position = layout.chunks[chunk]->getPosition();
+  for (const glm::ivec2& offset : NEIGHBOURS) {
+    const long other = layout.find(position + offset);
+    if (other < 0 || !isLower(position, position + offset)) {
+      continue;
+    }
+    for (const data::buildings::Building& otherBuilding : candidates[other]) {
+      if (data::intersects(from, to, glm::ivec2(otherBuilding.x, otherBuilding.y), getEnd(otherBuilding))) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+glm::ivec2 WorldGenerator::getEnd(const data::buildings::Building& building) {
+  return glm::ivec2(building.x + building.width - 1, building.y + building.length - 1);
+}
+}
@@ -0,0 +1,76 @@
+#ifndef WORLD_WORLDGENERATOR_HPP
+#define WORLD_WORLDGENERATOR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../data/Chunk.hpp"
+#include "../engine/Random.hpp"
+#include "Map.hpp"
+#include "ParallelFor.hpp"
+#include "settings.hpp"
+
+namespace world {
+
+/**
+ * Places random buildings on existing chunks of the map. Each chunk is generated on its own, with engine::Random
+ * stream of its position, so the same seed gives the same city for any thread count.
+ *
+ * Buildings start in their own chunk but can stick into neighbouring ones. When candidates of two chunks overlap, the
+ * one from chunk with lower position is dropped, which settles border conflicts regardless of processing order.
+ */
+class WorldGenerator {
+
+public:
+  struct Settings {
+    unsigned int buildingsPerChunk = 20;
+    unsigned int maxCollisionTries = 20;
+    unsigned int minBuildingSide = 2;
+    unsigned int maxBuildingSideDifference = 3;
+    unsigned int minBuildingHeight = 1;
+    unsigned int maxBuildingHeightDifference = 6;
+    HeightDistribution heightDistribution = HeightDistribution::UNIFORM;
+  };
+
+  WorldGenerator(unsigned int seed);
+  WorldGenerator(unsigned int seed, const Settings& settings);
+
+  /**
+   * Buildings are checked against roads and buildings already on the map. Result is ordered by chunks, as returned
+   * by Map::getChunks().
+   *
+   * @param threadCount 0 uses all hardware threads
+   */
+  std::vector<data::buildings::Building> generateBuildings(Map& map, unsigned int threadCount = 0) const;
+  void populate(Map& map, unsigned int threadCount = 0) const;
+
+protected:
+  // Chunks of the map with lookup by position
+  struct Layout {
+    std::vector<data::Chunk*> chunks;
+    std::map<std::pair<int, int>, unsigned long> indices;
+    // Of bounding box of chunks, in chunks
+    glm::vec2 center;
+    float radius;
+
+    // -1 if there is no chunk
+    long find(glm::ivec2 position) const;
+  };
+
+  unsigned int seed;
+  Settings settings;
+
+  std::vector<data::buildings::Building> generateCandidates(const Layout& layout, unsigned long chunk) const;
+  unsigned short getLevel(engine::Random::Stream& random, float centrality) const;
+  bool isFree(const data::buildings::Building& building, const Layout& layout, unsigned long chunk) const;
+  bool hasBorderConflict(const data::buildings::Building& building, const Layout& layout, unsigned long chunk,
+                         const std::vector<std::vector<data::buildings::Building>>& candidates) const;
+
+  static glm::ivec2 getEnd(const data::buildings::Building& building);
+};
+}
+
+#endif
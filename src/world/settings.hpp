@@ -3,8 +3,33 @@
 
 namespace world {
 
+enum class HeightDistribution {
+  UNIFORM,
+  // Mostly low buildings with few tall ones
+  SKEWED,
+  // Tallest buildings in the middle of the map, lower towards the edges
+  DOWNTOWN
+};
+
 struct settings {
   bool showGrid = true;
+  // Seed of engine::Random, picked from time when not given
+  bool hasSeed = false;
+  unsigned int seed = 0;
+
+  // Generated map replacing the default one when size is not zero, see ScenarioGenerator
+  struct Scenario {
+    unsigned int width = 0;
+    unsigned int height = 0;
+    // Distance between parallel roads in tiles, no roads when zero
+    unsigned int roadSpacing = 16;
+    // Share of blocks between roads with a lot
+    float lotDensity = 0.5f;
+    unsigned int buildingsPerChunk = 20;
+    unsigned int minBuildingHeight = 1;
+    unsigned int maxBuildingHeight = 6;
+    HeightDistribution heightDistribution = HeightDistribution::UNIFORM;
+  } scenario;
 };
 }
 
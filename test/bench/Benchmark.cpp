@@ -0,0 +1,70 @@
+#include "Benchmark.hpp"
+
+namespace bench {
+
+State::State(unsigned long iterations)
+    : iterations(iterations), remaining(iterations), started(false), paused(false), elapsed(0), itemsProcessed(0) {
+}
+
+bool State::keepRunning() {
+  if (!started) {
+    started = true;
+    start = Clock::now();
+  }
+  if (remaining == 0) {
+    pauseTiming();
+    return false;
+  }
+  remaining--;
+  return true;
+}
+
+void State::pauseTiming() {
+  if (paused) {
+    return;
+  }
+  elapsed += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+  paused = true;
+}
+
+void State::resumeTiming() {
+  if (!paused) {
+    return;
+  }
+  start = Clock::now();
+  paused = false;
+}
+
+void State::setItemsProcessed(unsigned long items) {
+  itemsProcessed = items;
+}
+
+void State::setLabel(const std::string& label) {
+  this->label = label;
+}
+
+unsigned long State::getIterations() const {
+  return iterations;
+}
+
+std::chrono::nanoseconds State::getElapsed() const {
+  return elapsed;
+}
+
+unsigned long State::getItemsProcessed() const {
+  return itemsProcessed;
+}
+
+const std::string& State::getLabel() const {
+  return label;
+}
+
+Registration::Registration(const char* name, Function function) {
+  getBenchmarks().push_back(Benchmark{name, function});
+}
+
+std::vector<Benchmark>& getBenchmarks() {
+  static std::vector<Benchmark> benchmarks;
+  return benchmarks;
+}
+}
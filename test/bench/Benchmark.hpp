@@ -0,0 +1,71 @@
+#ifndef BENCH_BENCHMARK_HPP
+#define BENCH_BENCHMARK_HPP
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+/**
+ * Controls single benchmark run. Body of benchmark should loop while keepRunning() returns true. Timing paused inside
+ * the body stays paused until resumeTiming().
+ */
+class State {
+  typedef std::chrono::steady_clock Clock;
+
+public:
+  State(unsigned long iterations);
+
+  bool keepRunning();
+  void pauseTiming();
+  void resumeTiming();
+
+  void setItemsProcessed(unsigned long items);
+  void setLabel(const std::string& label);
+
+  unsigned long getIterations() const;
+  std::chrono::nanoseconds getElapsed() const;
+  unsigned long getItemsProcessed() const;
+  const std::string& getLabel() const;
+
+protected:
+  unsigned long iterations;
+  unsigned long remaining;
+  bool started;
+  bool paused;
+
+  Clock::time_point start;
+  std::chrono::nanoseconds elapsed;
+
+  unsigned long itemsProcessed;
+  std::string label;
+};
+
+typedef void (*Function)(State&);
+
+struct Registration {
+  Registration(const char* name, Function function);
+};
+
+struct Benchmark {
+  std::string name;
+  Function function;
+};
+
+std::vector<Benchmark>& getBenchmarks();
+
+/**
+ * Keeps compiler from optimizing away computed value.
+ */
+template <typename T> void doNotOptimize(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+}
+
+#define BENCHMARK(name)                                                                                                \
+  static void name(bench::State& state);                                                                               \
+  static bench::Registration name##Registration(#name, name);                                                          \
+  static void name(bench::State& state)
+
+#endif
@@ -0,0 +1,129 @@
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+const glm::ivec2 CITY_SIZE = glm::ivec2(16, 16);
+constexpr unsigned int QUERIES = 1000;
+
+// Densely built city, like MapState::createRandomWorld() makes, only bigger
+class City {
+public:
+  City() : testWorld(CITY_SIZE) {
+    std::mt19937 random(1);
+    const glm::ivec2 tiles = CITY_SIZE * (int)data::Chunk::SIDE_LENGTH;
+    for (unsigned int i = 0; i < 100000; i++) {
+      data::buildings::Building building;
+      building.objectId = 0;
+      building.width = 2 + random() % 3;
+      building.length = 2 + random() % 3;
+      building.level = 1 + random() % 6;
+      building.x = random() % (tiles.x - building.width + 1);
+      building.y = random() % (tiles.y - building.length + 1);
+      if (!testWorld.getGeometry().checkCollisions(building)) {
+        testWorld.getWorld().getMap().addBuilding(building);
+      }
+    }
+    for (unsigned int i = 0; i < QUERIES; i++) {
+      const glm::ivec2 from = glm::ivec2(random() % (tiles.x - 16), random() % (tiles.y - 16));
+      queries.push_back(std::make_pair(from, from + glm::ivec2(random() % 16, random() % 16)));
+    }
+  }
+
+  support::TestWorld testWorld;
+  std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+};
+
+City& getCity() {
+  static City city;
+  return city;
+}
+}
+
+BENCHMARK(Geometry_GetBuildings) {
+  City& city = getCity();
+  while (state.keepRunning()) {
+    for (const std::pair<glm::ivec2, glm::ivec2>& query : city.queries) {
+      bench::doNotOptimize(city.testWorld.getGeometry().getBuildings(query.first, query.second).size());
+    }
+  }
+  state.setItemsProcessed(QUERIES * state.getIterations());
+  state.setLabel(std::to_string(city.testWorld.getWorld().getMap().getBuildingCount()) + " buildings");
+}
+
+BENCHMARK(Geometry_CheckCollisions_Building) {
+  City& city = getCity();
+  while (state.keepRunning()) {
+    for (const std::pair<glm::ivec2, glm::ivec2>& query : city.queries) {
+      data::buildings::Building building;
+      building.x = query.first.x;
+      building.y = query.first.y;
+      building.width = query.second.x - query.first.x + 1;
+      building.length = query.second.y - query.first.y + 1;
+      bench::doNotOptimize(city.testWorld.getGeometry().checkCollisions(building));
+    }
+  }
+  state.setItemsProcessed(QUERIES * state.getIterations());
+}
+
+namespace {
+
+const glm::ivec2 LARGE_CITY_SIZE = glm::ivec2(40, 40);
+constexpr unsigned int RAYS = 1000;
+
+// Grid of 3x3 buildings with one tile gaps, added directly to skip collision checks
+class LargeCity {
+public:
+  LargeCity() : testWorld(LARGE_CITY_SIZE) {
+    std::mt19937 random(2);
+    const glm::ivec2 tiles = LARGE_CITY_SIZE * (int)data::Chunk::SIDE_LENGTH;
+    for (int x = 0; x < tiles.x; x += 4) {
+      for (int y = 0; y < tiles.y; y += 4) {
+        data::buildings::Building building;
+        building.objectId = 0;
+        building.x = x;
+        building.y = y;
+        building.width = 3;
+        building.length = 3;
+        building.level = 1 + random() % 20;
+        testWorld.getWorld().getMap().addBuilding(building);
+      }
+    }
+
+    // Camera looking down at 45 degrees from the default distance, rotated randomly
+    std::uniform_real_distribution<float> unit(0.f, 1.f);
+    for (unsigned int i = 0; i < RAYS; i++) {
+      const glm::vec3 target = glm::vec3(unit(random) * tiles.x, 0, unit(random) * tiles.y);
+      const float angle = 6.2832f * unit(random);
+      const glm::vec3 ray = glm::vec3(std::cos(angle), -1.f, std::sin(angle));
+      rays.push_back(std::make_pair(target - 30.f * ray, ray));
+    }
+  }
+
+  support::TestWorld testWorld;
+  std::vector<std::pair<glm::vec3, glm::vec3>> rays;
+};
+
+LargeCity& getLargeCity() {
+  static LargeCity city;
+  return city;
+}
+}
+
+BENCHMARK(Geometry_HitBuilding) {
+  LargeCity& city = getLargeCity();
+  while (state.keepRunning()) {
+    for (const std::pair<glm::vec3, glm::vec3>& ray : city.rays) {
+      float distance = std::numeric_limits<float>::infinity();
+      data::buildings::Building hit;
+      bench::doNotOptimize(city.testWorld.getGeometry().hitBuilding(ray.first, ray.second, distance, hit));
+    }
+  }
+  state.setItemsProcessed(RAYS * state.getIterations());
+  state.setLabel(std::to_string(city.testWorld.getWorld().getMap().getBuildingCount()) + " buildings");
+}
@@ -0,0 +1,72 @@
+#include <string>
+#include <vector>
+
+#include <glm/ext.hpp>
+
+#include "../../src/world/Camera.hpp"
+#include "../../src/world/Frustum.hpp"
+#include "../../src/world/ScenarioGenerator.hpp"
+#include "../../src/world/VisibleRegion.hpp"
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+class City {
+public:
+  City() : testWorld(glm::ivec2(0, 0)) {
+    world::settings::Scenario scenario;
+    world::ScenarioGenerator::getPreset("1k", scenario);
+    world::ScenarioGenerator(1, scenario).generate(testWorld.getWorld().getMap());
+    chunks = testWorld.getWorld().getMap().getChunks();
+
+    // Same perspective as MapState, few tiles above the street in the middle of the city, looking along it
+    world::PerspectiveState perspective{glm::radians(45.f), 16.f / 9, 0.1f, 10000.f};
+    data::CameraState camera;
+    camera.lookAt = glm::vec3(scenario.width, 0, scenario.height) * (data::Chunk::SIDE_LENGTH / 2.f);
+    camera.distance = 20;
+    camera.rotationAroundX = 0.1f;
+    camera.rotationAroundY = 0.5f;
+    streetCamera.init(perspective, camera);
+
+    // Cached between frames in the game, renderer tests only its chunks
+    world::VisibleRegion region(testWorld.getWorld().getMap(), streetCamera);
+    region.update();
+    candidates = region.getChunks();
+  }
+
+  support::TestWorld testWorld;
+  std::vector<data::Chunk*> chunks;
+  world::Camera streetCamera;
+  std::vector<data::Chunk*> candidates;
+};
+
+City& getCity() {
+  static City city;
+  return city;
+}
+
+// Instances WorldRenderer::renderWorld() submits for given visibility
+unsigned long countBuildings(const std::vector<data::Chunk*>& chunks, const std::vector<unsigned int>& visible) {
+  unsigned long result = 0;
+  for (unsigned int index : visible) {
+    result += chunks[index]->getResidentialSize();
+  }
+  return result;
+}
+}
+
+BENCHMARK(Culling_StreetLevel) {
+  City& city = getCity();
+  std::vector<unsigned int> visible;
+  while (state.keepRunning()) {
+    visible = world::cullChunks(city.candidates, world::Frustum(city.streetCamera.getViewProjectionMatrix()));
+    bench::doNotOptimize(visible.size());
+  }
+  state.setItemsProcessed(city.candidates.size() * state.getIterations());
+  // Visible out of region candidates out of all
+  state.setLabel(std::to_string(visible.size()) + "/" + std::to_string(city.candidates.size()) + "/" +
+                 std::to_string(city.chunks.size()) + " chunks, " +
+                 std::to_string(countBuildings(city.candidates, visible)) + "/" +
+                 std::to_string(city.testWorld.getWorld().getMap().getBuildingCount()) + " buildings");
+}
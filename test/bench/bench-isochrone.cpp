@@ -0,0 +1,62 @@
+#include <random>
+#include <vector>
+
+#include "../../src/world/Isochrone.hpp"
+#include "../support/RoadStreams.hpp"
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+const glm::ivec2 CITY_SIZE = glm::ivec2(8, 8);
+constexpr unsigned int FACILITIES = 200;
+constexpr unsigned int BUDGET = 48;
+
+class City {
+public:
+  City() : testWorld(CITY_SIZE) {
+    for (const data::Road& road : support::gridRoads(1, 4000, CITY_SIZE, 8)) {
+      testWorld.addRoad(road);
+    }
+
+    std::vector<const data::RoadGraph::Node*> nodes;
+    for (const data::Chunk* chunk : testWorld.getWorld().getMap().getChunks()) {
+      for (const data::RoadGraph::Node& node : chunk->getRoadGraph().getNodes()) {
+        nodes.push_back(&node);
+      }
+    }
+    std::mt19937 random(1);
+    for (unsigned int i = 0; i < FACILITIES; i++) {
+      facilities.push_back(nodes[random() % nodes.size()]);
+    }
+  }
+
+  support::TestWorld testWorld;
+  std::vector<const data::RoadGraph::Node*> facilities;
+};
+
+City& getCity() {
+  static City city;
+  return city;
+}
+}
+
+BENCHMARK(Isochrone_Facilities_OneByOne) {
+  City& city = getCity();
+  world::Isochrone isochrone(city.testWorld.getWorld().getMap());
+  while (state.keepRunning()) {
+    for (const data::RoadGraph::Node* facility : city.facilities) {
+      bench::doNotOptimize(isochrone.query(*facility, BUDGET).nodes.size());
+    }
+  }
+  state.setItemsProcessed(FACILITIES * state.getIterations());
+}
+
+BENCHMARK(Isochrone_Facilities_MultiSource) {
+  City& city = getCity();
+  world::Isochrone isochrone(city.testWorld.getWorld().getMap());
+  while (state.keepRunning()) {
+    bench::doNotOptimize(isochrone.query(city.facilities, BUDGET).nodes.size());
+  }
+  state.setItemsProcessed(FACILITIES * state.getIterations());
+}
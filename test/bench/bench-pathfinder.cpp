@@ -0,0 +1,77 @@
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../src/world/Pathfinder.hpp"
+#include "../../src/world/WorldGenerator.hpp"
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+const glm::ivec2 CITY_SIZE = glm::ivec2(8, 8);
+constexpr unsigned int QUERIES = 1000;
+constexpr int MAX_TRIP = 100;
+
+class City {
+public:
+  City() : testWorld(CITY_SIZE), pathfinder(testWorld.getWorld().getMap()) {
+    world::WorldGenerator::Settings settings;
+    settings.buildingsPerChunk = 150;
+    world::WorldGenerator(1, settings).populate(testWorld.getWorld().getMap());
+    pathfinder.rebuild();
+
+    // Trips across few chunks, like pedestrians walking to work
+    std::mt19937 random(1);
+    const glm::ivec2 tiles = CITY_SIZE * (int)data::Chunk::SIDE_LENGTH;
+    while (queries.size() < QUERIES) {
+      const glm::ivec2 from = glm::ivec2(random() % tiles.x, random() % tiles.y);
+      const glm::ivec2 to = from + glm::ivec2(random() % (2 * MAX_TRIP), random() % (2 * MAX_TRIP)) - MAX_TRIP;
+      if (pathfinder.isFree(from) && pathfinder.isFree(to)) {
+        queries.push_back(world::Pathfinder::Query{from, to});
+      }
+    }
+  }
+
+  support::TestWorld testWorld;
+  world::Pathfinder pathfinder;
+  std::vector<world::Pathfinder::Query> queries;
+};
+
+City& getCity() {
+  static City city;
+  return city;
+}
+
+void findPaths(bench::State& state, unsigned int threadCount) {
+  City& city = getCity();
+  std::vector<world::Pathfinder::Path> paths;
+  while (state.keepRunning()) {
+    city.pathfinder.findPaths(city.queries, paths, threadCount);
+    bench::doNotOptimize(paths.back().length);
+  }
+  state.setItemsProcessed(QUERIES * state.getIterations());
+  state.setLabel(std::to_string(city.testWorld.getWorld().getMap().getBuildingCount()) + " buildings, " +
+                 std::to_string(threadCount) + " threads");
+}
+}
+
+BENCHMARK(Pathfinder_OneByOne) {
+  City& city = getCity();
+  world::Pathfinder::Path path;
+  while (state.keepRunning()) {
+    for (const world::Pathfinder::Query& query : city.queries) {
+      city.pathfinder.findPath(query.from, query.to, path);
+      bench::doNotOptimize(path.length);
+    }
+  }
+  state.setItemsProcessed(QUERIES * state.getIterations());
+}
+
+BENCHMARK(Pathfinder_Batch_Threads1) {
+  findPaths(state, 1);
+}
+
+BENCHMARK(Pathfinder_Batch_Threads4) {
+  findPaths(state, 4);
+}
@@ -0,0 +1,88 @@
+#include <random>
+#include <vector>
+
+#include "../../src/data/RectArray.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+constexpr unsigned int RECTS = 4096;
+constexpr unsigned int QUERIES = 256;
+
+// Road-like rectangles scattered over a chunk row, most queries miss most of them
+class Rects {
+public:
+  Rects() {
+    std::mt19937 random(5);
+    for (unsigned int i = 0; i < RECTS; i++) {
+      const glm::ivec2 from = glm::ivec2(random() % 4096, random() % 64);
+      const glm::ivec2 to = from + ((random() % 2) ? glm::ivec2(1, random() % 32) : glm::ivec2(random() % 32, 1));
+      array.add(from, to);
+      rects.push_back(std::make_pair(from, to));
+    }
+    for (unsigned int i = 0; i < QUERIES; i++) {
+      const glm::ivec2 from = glm::ivec2(random() % 4096, random() % 64);
+      queries.push_back(std::make_pair(from, from + glm::ivec2(random() % 4, random() % 4)));
+    }
+  }
+
+  data::RectArray array;
+  std::vector<std::pair<glm::ivec2, glm::ivec2>> rects;
+  std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+};
+
+Rects& getRects() {
+  static Rects rects;
+  return rects;
+}
+
+const char* getKernel() {
+#if defined(__AVX2__)
+  return "AVX2";
+#elif defined(__SSE2__)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
+}
+
+// Items are rectangle tests, i.e. rectangles times queries
+BENCHMARK(Rects_ScalarLoop) {
+  Rects& rects = getRects();
+  while (state.keepRunning()) {
+    for (const std::pair<glm::ivec2, glm::ivec2>& query : rects.queries) {
+      unsigned int hits = 0;
+      for (const std::pair<glm::ivec2, glm::ivec2>& rect : rects.rects) {
+        hits += data::intersects(rect.first, rect.second, query.first, query.second);
+      }
+      bench::doNotOptimize(hits);
+    }
+  }
+  state.setItemsProcessed((uint64_t)RECTS * QUERIES * state.getIterations());
+}
+
+BENCHMARK(Rects_HitMask) {
+  Rects& rects = getRects();
+  std::vector<uint64_t> mask;
+  while (state.keepRunning()) {
+    for (const std::pair<glm::ivec2, glm::ivec2>& query : rects.queries) {
+      rects.array.getHitMask(query.first, query.second, mask);
+      bench::doNotOptimize(mask.data());
+    }
+  }
+  state.setItemsProcessed((uint64_t)RECTS * QUERIES * state.getIterations());
+  state.setLabel(getKernel());
+}
+
+// Scans whole array whenever query hits nothing, which is the common case for collision checks
+BENCHMARK(Rects_FindFirst) {
+  Rects& rects = getRects();
+  while (state.keepRunning()) {
+    for (const std::pair<glm::ivec2, glm::ivec2>& query : rects.queries) {
+      bench::doNotOptimize(rects.array.findFirst(query.first, query.second));
+    }
+  }
+  state.setItemsProcessed((uint64_t)RECTS * QUERIES * state.getIterations());
+  state.setLabel(getKernel());
+}
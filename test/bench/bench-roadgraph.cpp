@@ -0,0 +1,144 @@
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../../src/data/RoadGraph.hpp"
+#include "../support/RoadStreams.hpp"
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+typedef std::vector<std::pair<glm::ivec2, data::Road>> ChunkRoads;
+
+const glm::ivec2 MAP_SIZE = glm::ivec2(2, 2);
+constexpr unsigned int STREAMS = 8;
+
+std::vector<std::vector<data::Road>> randomStreams() {
+  std::vector<std::vector<data::Road>> result;
+  for (unsigned int seed = 1; seed <= STREAMS; seed++) {
+    result.push_back(support::randomRoads(seed, 120, MAP_SIZE, 40));
+  }
+  return result;
+}
+
+std::vector<std::vector<data::Road>> gridStreams() {
+  std::vector<std::vector<data::Road>> result;
+  for (unsigned int seed = 1; seed <= STREAMS; seed++) {
+    result.push_back(support::gridRoads(seed, 60, MAP_SIZE, 8));
+  }
+  return result;
+}
+
+// Roads accepted by collision checks, already split by chunks
+ChunkRoads acceptedRoads(const std::vector<data::Road>& stream) {
+  ChunkRoads result;
+  support::TestWorld testWorld(MAP_SIZE);
+  for (const data::Road& road : stream) {
+    if (testWorld.addRoad(road)) {
+      for (const data::Road& part : testWorld.getGeometry().splitRoadByChunks(road)) {
+        result.push_back(std::make_pair(part.position.getChunk(), part));
+      }
+    }
+  }
+  return result;
+}
+
+void replayThroughGeometry(bench::State& state, const std::vector<std::vector<data::Road>>& streams) {
+  unsigned long roads = 0;
+  while (state.keepRunning()) {
+    for (const std::vector<data::Road>& stream : streams) {
+      support::TestWorld testWorld(MAP_SIZE);
+      for (const data::Road& road : stream) {
+        testWorld.addRoad(road);
+      }
+      roads += stream.size();
+    }
+  }
+  state.setItemsProcessed(roads);
+}
+
+void replayIntoGraphs(bench::State& state, const std::vector<std::vector<data::Road>>& streams) {
+  std::vector<ChunkRoads> accepted;
+  for (const std::vector<data::Road>& stream : streams) {
+    accepted.push_back(acceptedRoads(stream));
+  }
+
+  unsigned long roads = 0;
+  while (state.keepRunning()) {
+    for (const ChunkRoads& stream : accepted) {
+      std::map<std::pair<int, int>, data::RoadGraph> graphs;
+      for (const std::pair<glm::ivec2, data::Road>& road : stream) {
+        graphs[std::make_pair(road.first.x, road.first.y)].addRoad(road.second);
+      }
+      bench::doNotOptimize(graphs.size());
+      roads += stream.size();
+    }
+  }
+  state.setItemsProcessed(roads);
+}
+}
+
+BENCHMARK(RoadGraph_RandomStreams_Geometry) {
+  replayThroughGeometry(state, randomStreams());
+}
+
+BENCHMARK(RoadGraph_RandomStreams_AddRoad) {
+  replayIntoGraphs(state, randomStreams());
+}
+
+BENCHMARK(RoadGraph_GridStreams_Geometry) {
+  replayThroughGeometry(state, gridStreams());
+}
+
+BENCHMARK(RoadGraph_GridStreams_AddRoad) {
+  replayIntoGraphs(state, gridStreams());
+}
+
+namespace {
+
+const glm::ivec2 CITY_SIZE = glm::ivec2(8, 8);
+
+// Accepted grid roads of a large map, split by chunks
+const std::vector<data::Road>& cityRoads() {
+  static std::vector<data::Road> result;
+  if (result.empty()) {
+    support::TestWorld testWorld(CITY_SIZE);
+    for (const data::Road& road : support::gridRoads(1, 4000, CITY_SIZE, 8)) {
+      if (testWorld.addRoad(road)) {
+        const std::vector<data::Road> split = testWorld.getGeometry().splitRoadByChunks(road);
+        result.insert(result.end(), split.begin(), split.end());
+      }
+    }
+  }
+  return result;
+}
+
+void loadCity(bench::State& state, bool bulk) {
+  const std::vector<data::Road>& roads = cityRoads();
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    support::TestWorld testWorld(CITY_SIZE);
+    state.resumeTiming();
+
+    if (bulk) {
+      testWorld.getWorld().getMap().buildRoads(roads);
+    } else {
+      testWorld.getWorld().getMap().addRoads(roads);
+    }
+    bench::doNotOptimize(testWorld.getWorld().getMap().getChunksCount());
+
+    state.pauseTiming();
+  }
+  state.setItemsProcessed(roads.size() * state.getIterations());
+  state.setLabel(std::to_string(roads.size()) + " roads");
+}
+}
+
+BENCHMARK(RoadGraph_LoadCity_AddRoads) {
+  loadCity(state, false);
+}
+
+BENCHMARK(RoadGraph_LoadCity_BuildRoads) {
+  loadCity(state, true);
+}
@@ -0,0 +1,35 @@
+#include <string>
+
+#include "../../src/world/ScenarioGenerator.hpp"
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+void generate(bench::State& state, const std::string& preset) {
+  world::settings::Scenario scenario;
+  world::ScenarioGenerator::getPreset(preset, scenario);
+  unsigned long buildingCount = 0;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    support::TestWorld testWorld(glm::ivec2(0, 0));
+    state.resumeTiming();
+
+    world::ScenarioGenerator(1, scenario).generate(testWorld.getWorld().getMap());
+    buildingCount = testWorld.getWorld().getMap().getBuildingCount();
+
+    state.pauseTiming();
+  }
+  state.setItemsProcessed(scenario.width * scenario.height * state.getIterations());
+  state.setLabel(std::to_string(buildingCount) + " buildings");
+}
+}
+
+// Chunks per second, 100k preset is left for the game itself: --scenario=100k
+BENCHMARK(Scenario_Generate1k) {
+  generate(state, "1k");
+}
+
+BENCHMARK(Scenario_Generate10k) {
+  generate(state, "10k");
+}
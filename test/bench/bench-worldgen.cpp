@@ -0,0 +1,81 @@
+#include <random>
+#include <string>
+
+#include "../../src/world/WorldGenerator.hpp"
+#include "../support/TestWorld.hpp"
+#include "Benchmark.hpp"
+
+namespace {
+
+const glm::ivec2 WORLD_SIZE = glm::ivec2(16, 16);
+
+// Old MapState::createRandomWorld() loop: map-wide collision check for every attempt
+void generateSequentially(bench::State& state) {
+  const world::WorldGenerator::Settings settings;
+  unsigned long buildingCount = 0;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    support::TestWorld testWorld(WORLD_SIZE);
+    std::mt19937 random(1);
+    state.resumeTiming();
+
+    const glm::ivec2 tiles = WORLD_SIZE * (int)data::Chunk::SIDE_LENGTH;
+    for (unsigned int i = 0; i < settings.buildingsPerChunk * WORLD_SIZE.x * WORLD_SIZE.y; i++) {
+      for (unsigned int j = 0; j < settings.maxCollisionTries; j++) {
+        data::buildings::Building building;
+        building.objectId = 0;
+        building.width = random() % settings.maxBuildingSideDifference + settings.minBuildingSide;
+        building.length = random() % settings.maxBuildingSideDifference + settings.minBuildingSide;
+        building.level = random() % settings.maxBuildingHeightDifference + settings.minBuildingHeight;
+        building.x = random() % (tiles.x - building.width + 1);
+        building.y = random() % (tiles.y - building.length + 1);
+        if (!testWorld.getGeometry().checkCollisions(building)) {
+          testWorld.getWorld().getMap().addBuilding(building);
+          break;
+        }
+      }
+    }
+    buildingCount = testWorld.getWorld().getMap().getBuildingCount();
+
+    state.pauseTiming();
+  }
+  state.setItemsProcessed(buildingCount * state.getIterations());
+  state.setLabel(std::to_string(buildingCount) + " buildings");
+}
+
+void generate(bench::State& state, unsigned int threadCount) {
+  unsigned long buildingCount = 0;
+  while (state.keepRunning()) {
+    state.pauseTiming();
+    support::TestWorld testWorld(WORLD_SIZE);
+    state.resumeTiming();
+
+    world::WorldGenerator(1).populate(testWorld.getWorld().getMap(), threadCount);
+    buildingCount = testWorld.getWorld().getMap().getBuildingCount();
+
+    state.pauseTiming();
+  }
+  state.setItemsProcessed(buildingCount * state.getIterations());
+  state.setLabel(std::to_string(buildingCount) + " buildings, " + std::to_string(threadCount) + " threads");
+}
+}
+
+BENCHMARK(WorldGen_Sequential) {
+  generateSequentially(state);
+}
+
+BENCHMARK(WorldGen_Threads1) {
+  generate(state, 1);
+}
+
+BENCHMARK(WorldGen_Threads2) {
+  generate(state, 2);
+}
+
+BENCHMARK(WorldGen_Threads4) {
+  generate(state, 4);
+}
+
+BENCHMARK(WorldGen_Threads8) {
+  generate(state, 8);
+}
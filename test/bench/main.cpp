@@ -0,0 +1,40 @@
+#include <cstdio>
+#include <cstring>
+
+#include "Benchmark.hpp"
+
+namespace {
+constexpr std::chrono::milliseconds MIN_TIME(500);
+constexpr unsigned long MAX_ITERATIONS = 1000000000;
+
+bench::State run(const bench::Benchmark& benchmark) {
+  unsigned long iterations = 1;
+  while (true) {
+    bench::State state(iterations);
+    benchmark.function(state);
+    if (state.getElapsed() >= MIN_TIME || iterations >= MAX_ITERATIONS) {
+      return state;
+    }
+    iterations *= (state.getElapsed() * 10 < MIN_TIME) ? 10 : 2;
+  }
+}
+}
+
+// Usage: benchmarks [name filter]
+int main(int argc, char** argv) {
+  const char* filter = (argc > 1) ? argv[1] : "";
+
+  printf("%-48s %12s %14s %16s\n", "Benchmark", "Iterations", "ns/iteration", "items/s");
+  for (const bench::Benchmark& benchmark : bench::getBenchmarks()) {
+    if (nullptr == strstr(benchmark.name.c_str(), filter)) {
+      continue;
+    }
+
+    const bench::State state = run(benchmark);
+    const double nanosPerIteration = state.getElapsed().count() / (double)state.getIterations();
+    const double itemsPerSecond = state.getItemsProcessed() / (state.getElapsed().count() / 1e9);
+    printf("%-48s %12lu %14.0f %16.0f %s\n", benchmark.name.c_str(), state.getIterations(), nanosPerIteration,
+           itemsPerSecond, state.getLabel().c_str());
+  }
+  return 0;
+}
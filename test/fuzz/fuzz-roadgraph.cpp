@@ -0,0 +1,31 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include "../support/RoadGraphChecker.hpp"
+#include "../support/RoadStreams.hpp"
+#include "../support/TestWorld.hpp"
+
+// Inserts decoded roads the same way as the game does and checks road graphs after every accepted road.
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* bytes, size_t size) {
+  support::TestWorld testWorld(glm::ivec2(2, 2));
+  world::Map& map = testWorld.getWorld().getMap();
+
+  support::TileSet expectedTiles;
+  for (const data::Road& road : support::decodeRoads(bytes, size, testWorld.getMapSize())) {
+    if (!testWorld.addRoad(road)) {
+      continue;
+    }
+    support::addRoadTiles(road, expectedTiles);
+
+    const std::vector<std::string> errors = support::checkRoadGraphs(map);
+    for (const std::string& error : errors) {
+      fprintf(stderr, "%s\n", error.c_str());
+    }
+    if (!errors.empty() || expectedTiles != support::getRoadTiles(map)) {
+      fprintf(stderr, "Invalid graph after adding %s\n", road.describe().c_str());
+      abort();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+const glm::ivec2 MAP_SIZE = glm::ivec2(4, 3);
+
+int64_t getExpectedSum(const std::vector<data::buildings::Building>& buildings, world::TileQuantity quantity,
+                       glm::ivec2 from, glm::ivec2 to) {
+  // Only tiles on the map count
+  from = glm::max(from, glm::ivec2(0, 0));
+  to = glm::min(to, MAP_SIZE * (int)data::Chunk::SIDE_LENGTH - glm::ivec2(1, 1));
+  int64_t sum = 0;
+  for (const data::buildings::Building& building : buildings) {
+    const glm::ivec2 overlapFrom = glm::max(from, glm::ivec2(building.x, building.y));
+    const glm::ivec2 overlapTo =
+        glm::min(to, glm::ivec2(building.x + building.width - 1, building.y + building.length - 1));
+    if (overlapTo.x < overlapFrom.x || overlapTo.y < overlapFrom.y) {
+      continue;
+    }
+    const int64_t area = (overlapTo.x - overlapFrom.x + 1) * (overlapTo.y - overlapFrom.y + 1);
+    if (world::TileQuantity::FOOTPRINT == quantity) {
+      sum += area;
+    } else if (world::TileQuantity::FLOOR_AREA == quantity) {
+      sum += area * building.level;
+    } else if (overlapFrom == glm::ivec2(building.x, building.y)) {
+      sum++;
+    }
+  }
+  return sum;
+}
+
+void checkSums(support::TestWorld& testWorld, const std::vector<data::buildings::Building>& buildings,
+               std::mt19937& random) {
+  for (unsigned int i = 0; i < 300; i++) {
+    const glm::ivec2 from = glm::ivec2(random() % 300, random() % 220) - glm::ivec2(20, 20);
+    const glm::ivec2 to = from + glm::ivec2(random() % 150, random() % 150);
+    for (world::TileQuantity quantity :
+         {world::TileQuantity::FOOTPRINT, world::TileQuantity::FLOOR_AREA, world::TileQuantity::BUILDINGS}) {
+      EXPECT_EQ(getExpectedSum(buildings, quantity, from, to),
+                testWorld.getGeometry().getTileSum(quantity, from, to));
+    }
+  }
+}
+}
+
+TEST(AreaSumsTest, MatchesBuildingsAfterEdits) {
+  std::mt19937 random(13);
+  support::TestWorld testWorld(MAP_SIZE);
+
+  // Buildings overlap freely, sums do not care; only origins have to be unique for removal
+  std::vector<data::buildings::Building> buildings;
+  for (unsigned int i = 0; i < 500; i++) {
+    data::buildings::Building building;
+    building.objectId = 0;
+    building.x = random() % (MAP_SIZE.x * data::Chunk::SIDE_LENGTH - 10);
+    building.y = random() % (MAP_SIZE.y * data::Chunk::SIDE_LENGTH - 10);
+    building.width = 1 + random() % 10;
+    building.length = 1 + random() % 10;
+    building.level = 1 + random() % 6;
+    if (std::any_of(buildings.begin(), buildings.end(), [&](const data::buildings::Building& other) {
+          return other.x == building.x && other.y == building.y;
+        })) {
+      continue;
+    }
+    testWorld.getWorld().getMap().addBuilding(building);
+    buildings.push_back(building);
+  }
+  checkSums(testWorld, buildings, random);
+
+  for (unsigned int i = 0; i < 200; i++) {
+    const unsigned int index = random() % buildings.size();
+    testWorld.getWorld().getMap().removeBuilding(buildings[index]);
+    buildings.erase(buildings.begin() + index);
+  }
+  checkSums(testWorld, buildings, random);
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/data/Chunk.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+// Plain slab test, returns infinity when box is missed
+float getHitDistance(const data::buildings::Building& building, glm::vec3 origin, glm::vec3 direction) {
+  const glm::vec3 from = glm::vec3(building.x, 0, building.y);
+  const glm::vec3 to = from + glm::vec3(building.width, building.level, building.length);
+  float entry = 0;
+  float exit = std::numeric_limits<float>::infinity();
+  for (int axis = 0; axis < 3; axis++) {
+    const float t1 = (from[axis] - origin[axis]) / direction[axis];
+    const float t2 = (to[axis] - origin[axis]) / direction[axis];
+    entry = std::max(entry, std::min(t1, t2));
+    exit = std::min(exit, std::max(t1, t2));
+  }
+  return (entry <= exit) ? entry : std::numeric_limits<float>::infinity();
+}
+}
+
+TEST(BuildingBVHTest, MatchesLinearScan) {
+  std::mt19937 random(11);
+  data::Chunk chunk;
+  chunk.setPosition(glm::ivec2(2, 1));
+  const glm::ivec2 origin = chunk.getPosition() * (int)data::Chunk::SIDE_LENGTH;
+
+  std::vector<data::buildings::Building> all;
+  for (unsigned int i = 0; i < 400; i++) {
+    const data::buildings::Building building = support::makeBuilding(
+        origin.x + random() % 64, origin.y + random() % 64, 1 + random() % 6, 1 + random() % 6, 1 + random() % 8);
+    if (std::any_of(all.begin(), all.end(), [&](const data::buildings::Building& other) {
+          return other.x == building.x && other.y == building.y;
+        })) {
+      continue;
+    }
+    chunk.addBuilding(building);
+    all.push_back(building);
+  }
+  for (unsigned int i = 0; i < 150; i++) {
+    const unsigned int index = random() % all.size();
+    EXPECT_TRUE(chunk.removeBuilding(all[index]));
+    all.erase(all.begin() + index);
+  }
+
+  std::uniform_real_distribution<float> unit(-1.f, 1.f);
+  for (unsigned int i = 0; i < 500; i++) {
+    // Camera-like rays looking down from above the chunk
+    const glm::vec3 cameraPos = glm::vec3(origin.x + 32, 0, origin.y + 32) +
+                                glm::vec3(40 * unit(random), 12 + 8 * unit(random), 40 * unit(random));
+    const glm::vec3 ray = glm::vec3(unit(random), -1.f + 0.5f * unit(random), unit(random));
+
+    float expected = std::numeric_limits<float>::infinity();
+    for (const data::buildings::Building& building : all) {
+      expected = std::min(expected, getHitDistance(building, cameraPos, ray));
+    }
+
+    float distance = std::numeric_limits<float>::infinity();
+    data::buildings::Building hit;
+    ASSERT_EQ(!std::isinf(expected), chunk.hitBuilding(cameraPos, ray, distance, hit));
+    if (!std::isinf(expected)) {
+      // Boxes touching each other can be hit at the same distance, so only distance is compared
+      EXPECT_NEAR(expected, distance, 1e-4f);
+      EXPECT_NEAR(distance, getHitDistance(hit, cameraPos, ray), 1e-4f);
+    }
+  }
+}
+
+TEST(BuildingBVHTest, GeometryWalksChunksAlongRay) {
+  std::mt19937 random(5);
+  support::TestWorld testWorld(glm::ivec2(5, 4));
+  world::Map& map = testWorld.getWorld().getMap();
+  const glm::ivec2 tiles = testWorld.getMapSize() * (int)data::Chunk::SIDE_LENGTH;
+
+  // Buildings on chunk borders stick out of the chunk holding them
+  for (int x = 2; x < tiles.x; x += 9) {
+    for (int y = 5; y < tiles.y; y += 7) {
+      map.addBuilding(support::makeBuilding(x, y, 1 + random() % 8, 1 + random() % 6, 1 + random() % 12));
+    }
+  }
+
+  std::uniform_real_distribution<float> unit(-1.f, 1.f);
+  for (unsigned int i = 0; i < 500; i++) {
+    const glm::vec3 origin = glm::vec3(tiles.x * (0.5f + 0.7f * unit(random)), 6 + 10 * unit(random),
+                                       tiles.y * (0.5f + 0.7f * unit(random)));
+    // Every fifth ray is flat, to walk the whole map
+    const glm::vec3 ray = glm::vec3(unit(random), (i % 5) ? 0.5f * unit(random) : 0.f, unit(random));
+
+    float expected = std::numeric_limits<float>::infinity();
+    data::buildings::Building expectedHit;
+    for (const data::Chunk* chunk : map.getChunks()) {
+      chunk->hitBuilding(origin, ray, expected, expectedHit);
+    }
+
+    float distance = std::numeric_limits<float>::infinity();
+    data::buildings::Building hit;
+    ASSERT_EQ(!std::isinf(expected), testWorld.getGeometry().hitBuilding(origin, ray, distance, hit)) << i;
+    if (!std::isinf(expected)) {
+      EXPECT_NEAR(expected, distance, 1e-4f) << i;
+    }
+  }
+}
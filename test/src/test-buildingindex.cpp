@@ -0,0 +1,64 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/data/Chunk.hpp"
+#include "../support/MapObjects.hpp"
+
+namespace {
+
+bool overlaps(const data::buildings::Building& building, glm::ivec2 from, glm::ivec2 to) {
+  return !(building.x + building.width - 1 < from.x || to.x < building.x || building.y + building.length - 1 < from.y ||
+           to.y < building.y);
+}
+
+std::vector<std::pair<long, long>> positions(const std::vector<data::buildings::Building>& buildings) {
+  std::vector<std::pair<long, long>> result;
+  for (const data::buildings::Building& building : buildings) {
+    result.push_back(std::make_pair(building.x, building.y));
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+}
+
+TEST(BuildingIndexTest, MatchesLinearScan) {
+  std::mt19937 random(7);
+  data::Chunk chunk;
+  chunk.setPosition(glm::ivec2(1, 2));
+  const glm::ivec2 origin = chunk.getPosition() * (int)data::Chunk::SIDE_LENGTH;
+
+  // Buildings can stick out of the chunk, chunk removes them by position so it has to be unique
+  std::vector<data::buildings::Building> all;
+  for (unsigned int i = 0; i < 300; i++) {
+    const data::buildings::Building building = support::makeBuilding(origin.x + random() % 64, origin.y + random() % 64,
+                                                                     1 + random() % 12, 1 + random() % 12);
+    if (std::any_of(all.begin(), all.end(), [&](const data::buildings::Building& other) {
+          return other.x == building.x && other.y == building.y;
+        })) {
+      continue;
+    }
+    chunk.addBuilding(building);
+    all.push_back(building);
+  }
+  for (unsigned int i = 0; i < 100; i++) {
+    const unsigned int index = random() % all.size();
+    EXPECT_TRUE(chunk.removeBuilding(all[index]));
+    all.erase(all.begin() + index);
+  }
+
+  for (unsigned int i = 0; i < 500; i++) {
+    const glm::ivec2 from = origin + glm::ivec2(random() % 90, random() % 90) - glm::ivec2(10, 10);
+    const glm::ivec2 to = from + glm::ivec2(random() % 20, random() % 20);
+    std::vector<data::buildings::Building> expected;
+    std::copy_if(all.begin(), all.end(), std::back_inserter(expected),
+                 [&](const data::buildings::Building& building) { return overlaps(building, from, to); });
+
+    std::vector<data::buildings::Building> actual;
+    chunk.getBuildings(from, to, actual);
+    EXPECT_EQ(positions(expected), positions(actual));
+    EXPECT_EQ(!expected.empty(), chunk.hasBuildings(from, to));
+  }
+}
@@ -0,0 +1,87 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/world/DistanceField.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+const glm::ivec2 MAP_SIZE = glm::ivec2(3, 3);
+const unsigned int RADIUS = 40;
+
+float getExpectedDistance(const std::vector<world::DistanceField::Rect>& sources, world::DistanceMetric metric,
+                          glm::ivec2 tile) {
+  float result = world::DistanceField::FAR;
+  for (const world::DistanceField::Rect& source : sources) {
+    const glm::ivec2 offset = glm::max(glm::max(source.first - tile, tile - source.second), glm::ivec2(0, 0));
+    const float distance = (world::DistanceMetric::MANHATTAN == metric)
+                               ? offset.x + offset.y
+                               : std::sqrt((float)(offset.x * offset.x + offset.y * offset.y));
+    result = std::min(result, distance);
+  }
+  return (result <= RADIUS) ? result : world::DistanceField::FAR;
+}
+
+void checkField(const world::DistanceField& field, const std::vector<world::DistanceField::Rect>& sources,
+                world::DistanceMetric metric) {
+  const glm::ivec2 size = MAP_SIZE * (int)data::Chunk::SIDE_LENGTH;
+  for (int x = 0; x < size.x; x++) {
+    for (int y = 0; y < size.y; y++) {
+      const float expected = getExpectedDistance(sources, metric, glm::ivec2(x, y));
+      const float actual = field.getDistance(glm::ivec2(x, y));
+      if (std::isinf(expected)) {
+        ASSERT_TRUE(std::isinf(actual)) << "at " << x << ", " << y;
+      } else {
+        ASSERT_NEAR(expected, actual, 1e-3) << "at " << x << ", " << y;
+      }
+    }
+  }
+}
+}
+
+TEST(DistanceFieldTest, MatchesBruteForceAfterUpdate) {
+  for (world::DistanceMetric metric : {world::DistanceMetric::MANHATTAN, world::DistanceMetric::EUCLIDEAN}) {
+    std::mt19937 random(5);
+    support::TestWorld testWorld(MAP_SIZE);
+    world::Map& map = testWorld.getWorld().getMap();
+    ASSERT_TRUE(testWorld.addRoad(support::makeRoad(10, 60, data::Direction::W, 50)));
+    ASSERT_TRUE(testWorld.addRoad(support::makeRoad(150, 20, data::Direction::N, 30)));
+
+    std::vector<world::DistanceField::Rect> roads;
+    for (data::Chunk* chunk : map.getChunks()) {
+      world::DistanceField::roads()(*chunk, roads);
+    }
+    world::DistanceField roadField(map, world::DistanceField::roads(), metric, RADIUS);
+    checkField(roadField, roads, metric);
+
+    // Only tall buildings count, some of them cross chunk borders
+    world::DistanceField buildingField(
+        map, world::DistanceField::buildings([](const data::buildings::Building& b) { return b.level > 2; }), metric,
+        RADIUS);
+    std::vector<world::DistanceField::Rect> buildings;
+    for (unsigned int i = 0; i < 12; i++) {
+      data::buildings::Building building;
+      building.objectId = 0;
+      building.x = 20 + random() % 150;
+      building.y = 80 + random() % 100;
+      building.width = 1 + random() % 8;
+      building.length = 1 + random() % 8;
+      building.level = 1 + random() % 4;
+      map.addBuilding(building);
+      const glm::ivec2 from = glm::ivec2(building.x, building.y);
+      const glm::ivec2 to = from + glm::ivec2(building.width - 1, building.length - 1);
+      buildingField.update(from, to);
+      if (building.level > 2) {
+        buildings.push_back(std::make_pair(from, to));
+      }
+    }
+    checkField(buildingField, buildings, metric);
+
+    buildingField.rebuild();
+    checkField(buildingField, buildings, metric);
+  }
+}
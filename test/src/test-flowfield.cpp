@@ -0,0 +1,85 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/world/FlowField.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+const glm::ivec2 MAP_SIZE = glm::ivec2(3, 3);
+
+data::buildings::Building randomBuilding(std::mt19937& random) {
+  const glm::ivec2 size = MAP_SIZE * (int)data::Chunk::SIDE_LENGTH;
+  const long x = random() % (size.x - 10);
+  const long y = random() % (size.y - 10);
+  const unsigned short width = 1 + random() % 10;
+  const unsigned short length = 1 + random() % 10;
+  return support::makeBuilding(x, y, width, length);
+}
+
+void checkField(const world::FlowField& field, world::Map& map, const world::Pathfinder& pathfinder,
+                const std::vector<glm::ivec2>& goals) {
+  const world::FlowField expected(map, pathfinder, goals);
+  const glm::ivec2 size = MAP_SIZE * (int)data::Chunk::SIDE_LENGTH;
+  for (int x = 0; x < size.x; x++) {
+    for (int y = 0; y < size.y; y++) {
+      const glm::ivec2 tile = glm::ivec2(x, y);
+      if (expected.getCost(tile) == world::FlowField::UNREACHABLE) {
+        ASSERT_EQ(world::FlowField::UNREACHABLE, field.getCost(tile)) << "at " << x << ", " << y;
+      } else {
+        ASSERT_NEAR(expected.getCost(tile), field.getCost(tile), 1e-3) << "at " << x << ", " << y;
+      }
+      if (field.getCost(tile) == world::FlowField::UNREACHABLE || field.getCost(tile) == 0) {
+        ASSERT_EQ(glm::ivec2(0, 0), field.getStep(tile));
+        continue;
+      }
+      // Every step is legal and brings the agent closer by its cost
+      const glm::ivec2 step = field.getStep(tile);
+      ASSERT_TRUE(pathfinder.isFree(tile + step));
+      ASSERT_TRUE(pathfinder.isFree(tile + glm::ivec2(step.x, 0)));
+      ASSERT_TRUE(pathfinder.isFree(tile + glm::ivec2(0, step.y)));
+      const float stepCost = (step.x != 0 && step.y != 0) ? std::sqrt(2.f) : 1.f;
+      ASSERT_NEAR(field.getCost(tile), field.getCost(tile + step) + stepCost, 1e-3);
+    }
+  }
+}
+}
+
+TEST(FlowFieldTest, IncrementalUpdateMatchesRebuild) {
+  std::mt19937 random(9);
+  support::TestWorld testWorld(MAP_SIZE);
+  world::Map& map = testWorld.getWorld().getMap();
+  std::vector<data::buildings::Building> buildings;
+  for (unsigned int i = 0; i < 150; i++) {
+    buildings.push_back(randomBuilding(random));
+    map.addBuilding(buildings.back());
+  }
+
+  world::Pathfinder pathfinder(map);
+  const std::vector<glm::ivec2> goals{glm::ivec2(20, 150), glm::ivec2(170, 30)};
+  world::FlowField field(map, pathfinder, goals);
+  checkField(field, map, pathfinder, goals);
+
+  // Both new obstacles and cleared ones, away from the goals and next to them
+  for (unsigned int i = 0; i < 8; i++) {
+    data::buildings::Building building;
+    if (i % 2 == 0) {
+      building = randomBuilding(random);
+      map.addBuilding(building);
+    } else {
+      const unsigned int index = random() % buildings.size();
+      building = buildings[index];
+      map.removeBuilding(building);
+      buildings.erase(buildings.begin() + index);
+    }
+    const glm::ivec2 from = glm::ivec2(building.x, building.y);
+    const glm::ivec2 to = from + glm::ivec2(building.width - 1, building.length - 1);
+    pathfinder.update(from, to);
+    field.update(from, to);
+    checkField(field, map, pathfinder, goals);
+  }
+}
@@ -0,0 +1,94 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/data/Chunk.hpp"
+#include "../../src/world/Map.hpp"
+#include "../support/MapObjects.hpp"
+
+namespace {
+
+data::Lot makeLot(int x, int y, glm::ivec2 size, data::Direction direction) {
+  data::Lot lot;
+  lot.objectId = 0;
+  lot.position.setGlobal(glm::ivec2(x, y));
+  lot.size = size;
+  lot.direction = direction;
+  return lot;
+}
+}
+
+TEST(FrontageIndexTest, LotFacingRoad) {
+  data::Chunk chunk;
+  chunk.setPosition(glm::ivec2(0, 0));
+  chunk.addRoad(support::makeRoad(2, 10, data::Direction::W, 30));
+  chunk.addLot(makeLot(10, 4, glm::ivec2(6, 6), data::Direction::N));
+  chunk.addLot(makeLot(10, 12, glm::ivec2(6, 6), data::Direction::S));
+  chunk.addLot(makeLot(20, 12, glm::ivec2(6, 6), data::Direction::N));
+
+  const data::FrontageIndex& index = chunk.getFrontageIndex();
+  ASSERT_EQ(1u, chunk.getRoads().size());
+  EXPECT_EQ(&chunk.getRoads()[0], index.getFrontage(0).road);
+  EXPECT_EQ(&chunk.getRoads()[0], index.getFrontage(1).road);
+  EXPECT_FALSE(index.getFrontage(2).hasAccess());
+  EXPECT_EQ(std::vector<unsigned int>({0, 1}), index.getFrontingLots(chunk.getRoads()[0]));
+}
+
+TEST(FrontageIndexTest, UpdatedWhenRoadIsDivided) {
+  data::Chunk chunk;
+  chunk.setPosition(glm::ivec2(0, 0));
+  chunk.addRoad(support::makeRoad(2, 10, data::Direction::W, 30));
+  chunk.addLot(makeLot(4, 4, glm::ivec2(4, 6), data::Direction::N));
+  chunk.addLot(makeLot(20, 4, glm::ivec2(4, 6), data::Direction::N));
+  chunk.addRoad(support::makeRoad(14, 0, data::Direction::N, 30));
+
+  const data::FrontageIndex& index = chunk.getFrontageIndex();
+  const data::Road* first = index.getFrontage(0).road;
+  const data::Road* second = index.getFrontage(1).road;
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(first, second);
+  EXPECT_EQ(std::vector<unsigned int>({0}), index.getFrontingLots(*first));
+  EXPECT_EQ(std::vector<unsigned int>({1}), index.getFrontingLots(*second));
+}
+
+TEST(FrontageIndexTest, LotFacingOnlyNode) {
+  data::Chunk chunk;
+  chunk.setPosition(glm::ivec2(0, 0));
+  chunk.addRoad(support::makeRoad(10, 10, data::Direction::N, 20));
+  chunk.addLot(makeLot(10, 4, glm::ivec2(2, 6), data::Direction::N));
+
+  const data::FrontageIndex::Frontage& frontage = chunk.getFrontageIndex().getFrontage(0);
+  EXPECT_EQ(nullptr, frontage.road);
+  ASSERT_NE(nullptr, frontage.node);
+  EXPECT_EQ(glm::ivec2(10, 10), frontage.node->position.getGlobal());
+}
+
+TEST(FrontageIndexTest, LotFacingRoadAcrossChunkBorder) {
+  // Same result whether road or lot comes first
+  for (bool roadFirst : {true, false}) {
+    SCOPED_TRACE(roadFirst ? "road first" : "lot first");
+    world::Map map;
+    map.createChunks({glm::ivec2(0, 0), glm::ivec2(0, 1)});
+    if (roadFirst) {
+      map.addRoad(support::makeRoad(2, 64, data::Direction::W, 30));
+    }
+    ASSERT_TRUE(map.addLot(makeLot(10, 58, glm::ivec2(6, 6), data::Direction::N)));
+    if (!roadFirst) {
+      map.addRoad(support::makeRoad(2, 64, data::Direction::W, 30));
+    }
+
+    const data::Chunk& lotChunk = map.getChunk(glm::ivec2(0, 0));
+    const data::Chunk& roadChunk = map.getChunk(glm::ivec2(0, 1));
+    ASSERT_EQ(1u, roadChunk.getRoads().size());
+    const data::Road& road = roadChunk.getRoads()[0];
+    EXPECT_EQ(&road, lotChunk.getFrontageIndex().getFrontage(0).road);
+    EXPECT_TRUE(roadChunk.getFrontageIndex().getFrontingLots(road).empty());
+    const std::vector<data::FrontageIndex::BorderLot>& borderLots =
+        roadChunk.getFrontageIndex().getFrontingBorderLots(road);
+    ASSERT_EQ(1u, borderLots.size());
+    EXPECT_EQ(&lotChunk, borderLots[0].chunk);
+    EXPECT_EQ(0u, borderLots[0].lotIndex);
+    map.cleanup();
+  }
+}
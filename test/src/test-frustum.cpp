@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+
+#include <glm/ext.hpp>
+
+#include "../../src/world/Frustum.hpp"
+
+TEST(FrustumTest, KeepsOnlyBoxesInView) {
+  // Looking from above origin towards +x
+  const glm::mat4 projection = glm::perspective(glm::radians(60.f), 1.f, 0.1f, 500.f);
+  const glm::mat4 view = glm::lookAt(glm::vec3(0, 2, 0), glm::vec3(100, 2, 0), glm::vec3(0, 1, 0));
+  const world::Frustum frustum(projection * view);
+
+  EXPECT_TRUE(frustum.intersects(glm::vec3(50, 0, -5), glm::vec3(60, 4, 5)));
+  // Partially in view
+  EXPECT_TRUE(frustum.intersects(glm::vec3(10, 0, 5), glm::vec3(20, 4, 100)));
+  // Behind, to the side, beyond far plane and above
+  EXPECT_FALSE(frustum.intersects(glm::vec3(-60, 0, -5), glm::vec3(-50, 4, 5)));
+  EXPECT_FALSE(frustum.intersects(glm::vec3(10, 0, 30), glm::vec3(20, 4, 40)));
+  EXPECT_FALSE(frustum.intersects(glm::vec3(600, 0, -5), glm::vec3(610, 4, 5)));
+  EXPECT_FALSE(frustum.intersects(glm::vec3(10, 40, -5), glm::vec3(20, 50, 5)));
+}
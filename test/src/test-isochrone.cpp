@@ -0,0 +1,85 @@
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/world/Isochrone.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+const data::RoadGraph::Node& getNodeAt(world::Map& map, glm::ivec2 global) {
+  const data::RoadGraph& graph = map.getChunk(global / (int)data::Chunk::SIDE_LENGTH).getRoadGraph();
+  for (const data::RoadGraph::Node& node : graph.getNodes()) {
+    if (node.position.getGlobal() == global) {
+      return node;
+    }
+  }
+  throw std::invalid_argument("No node at given position");
+}
+
+unsigned int getDistance(const world::Isochrone::Result& result, glm::ivec2 global) {
+  for (unsigned int i = 0; i < result.nodes.size(); i++) {
+    if (result.nodes[i]->position.getGlobal() == global) {
+      return result.distances[i];
+    }
+  }
+  return std::numeric_limits<unsigned int>::max();
+}
+}
+
+TEST(IsochroneTest, BudgetLimitsReachedNodes) {
+  support::TestWorld testWorld(glm::ivec2(2, 2));
+  ASSERT_TRUE(testWorld.addRoad(support::makeRoad(2, 10, data::Direction::W, 100)));
+  ASSERT_TRUE(testWorld.addRoad(support::makeRoad(20, 2, data::Direction::N, 30)));
+  world::Map& map = testWorld.getWorld().getMap();
+  world::Isochrone isochrone(map);
+
+  const world::Isochrone::Result& near = isochrone.query(getNodeAt(map, glm::ivec2(2, 10)), 20);
+  EXPECT_EQ(0u, getDistance(near, glm::ivec2(2, 10)));
+  EXPECT_EQ(18u, getDistance(near, glm::ivec2(20, 10)));
+  EXPECT_EQ(2u, near.nodes.size());
+  EXPECT_EQ(4u, near.roads.size());
+
+  // Continues across chunk border up to the far dead end
+  const world::Isochrone::Result& far = isochrone.query(getNodeAt(map, glm::ivec2(2, 10)), 100);
+  EXPECT_EQ(99u, getDistance(far, glm::ivec2(101, 10)));
+  EXPECT_EQ(26u, getDistance(far, glm::ivec2(20, 2)));
+  EXPECT_EQ(39u, getDistance(far, glm::ivec2(20, 31)));
+}
+
+TEST(IsochroneTest, MultipleSourcesPickClosest) {
+  support::TestWorld testWorld(glm::ivec2(2, 2));
+  ASSERT_TRUE(testWorld.addRoad(support::makeRoad(2, 10, data::Direction::W, 100)));
+  world::Map& map = testWorld.getWorld().getMap();
+  world::Isochrone isochrone(map);
+
+  const std::vector<const data::RoadGraph::Node*> sources = {&getNodeAt(map, glm::ivec2(2, 10)),
+                                                             &getNodeAt(map, glm::ivec2(101, 10))};
+  const world::Isochrone::Result& result = isochrone.query(sources, 1000);
+  for (unsigned int i = 0; i < result.nodes.size(); i++) {
+    const bool west = result.nodes[i]->position.getGlobal().x < 52;
+    EXPECT_EQ(west ? 0u : 1u, result.sources[i]) << result.nodes[i]->position.getGlobal().x;
+  }
+  EXPECT_EQ(4u, result.nodes.size());
+  EXPECT_EQ(2u, result.roads.size());
+}
+
+TEST(IsochroneTest, ReachesFrontingLots) {
+  support::TestWorld testWorld(glm::ivec2(1, 1));
+  ASSERT_TRUE(testWorld.addRoad(support::makeRoad(2, 10, data::Direction::W, 40)));
+  data::Lot lot;
+  lot.objectId = 0;
+  lot.position.setGlobal(glm::ivec2(30, 4));
+  lot.size = glm::ivec2(4, 6);
+  lot.direction = data::Direction::N;
+  ASSERT_TRUE(testWorld.getWorld().getMap().addLot(lot));
+  world::Isochrone isochrone(testWorld.getWorld().getMap());
+
+  const world::Isochrone::Result& result =
+      isochrone.query(getNodeAt(testWorld.getWorld().getMap(), glm::ivec2(2, 10)), 5);
+  ASSERT_EQ(1u, result.lots.size());
+  EXPECT_EQ(0u, result.lots[0].index);
+}
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/world/Pathfinder.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+const glm::ivec2 MAP_SIZE = glm::ivec2(3, 2);
+
+// Plain Dijkstra over all 8 neighbours, with the same corner rule
+float getExpectedLength(const world::Pathfinder& pathfinder, glm::ivec2 from, glm::ivec2 to) {
+  const glm::ivec2 size = MAP_SIZE * (int)data::Chunk::SIDE_LENGTH;
+  std::vector<float> costs(size.x * size.y, INFINITY);
+  std::vector<std::pair<float, int>> open{std::make_pair(0.f, from.y * size.x + from.x)};
+  costs[open[0].second] = 0;
+  const auto later = std::greater<std::pair<float, int>>();
+  while (!open.empty()) {
+    std::pop_heap(open.begin(), open.end(), later);
+    const std::pair<float, int> entry = open.back();
+    open.pop_back();
+    if (entry.first > costs[entry.second]) {
+      continue;
+    }
+    const glm::ivec2 tile = glm::ivec2(entry.second % size.x, entry.second / size.x);
+    if (tile == to) {
+      return entry.first;
+    }
+    for (int dx = -1; dx <= 1; dx++) {
+      for (int dy = -1; dy <= 1; dy++) {
+        const glm::ivec2 next = tile + glm::ivec2(dx, dy);
+        if (next == tile || !pathfinder.isFree(next) || !pathfinder.isFree(tile + glm::ivec2(dx, 0)) ||
+            !pathfinder.isFree(tile + glm::ivec2(0, dy))) {
+          continue;
+        }
+        const float cost = entry.first + ((dx != 0 && dy != 0) ? std::sqrt(2.f) : 1.f);
+        if (cost < costs[next.y * size.x + next.x]) {
+          costs[next.y * size.x + next.x] = cost;
+          open.push_back(std::make_pair(cost, next.y * size.x + next.x));
+          std::push_heap(open.begin(), open.end(), later);
+        }
+      }
+    }
+  }
+  return INFINITY;
+}
+
+void checkPath(const world::Pathfinder& pathfinder, const world::Pathfinder::Path& path) {
+  float length = 0;
+  for (unsigned int i = 1; i < path.waypoints.size(); i++) {
+    const glm::ivec2 delta = path.waypoints[i] - path.waypoints[i - 1];
+    ASSERT_TRUE(delta.x == 0 || delta.y == 0 || std::abs(delta.x) == std::abs(delta.y));
+    const glm::ivec2 step = glm::ivec2((delta.x > 0) - (delta.x < 0), (delta.y > 0) - (delta.y < 0));
+    for (glm::ivec2 tile = path.waypoints[i - 1]; tile != path.waypoints[i]; tile += step) {
+      ASSERT_TRUE(pathfinder.isFree(tile + glm::ivec2(step.x, 0)));
+      ASSERT_TRUE(pathfinder.isFree(tile + glm::ivec2(0, step.y)));
+      ASSERT_TRUE(pathfinder.isFree(tile + step));
+    }
+    length += std::max(std::abs(delta.x), std::abs(delta.y)) * ((step.x != 0 && step.y != 0) ? std::sqrt(2.f) : 1.f);
+  }
+  EXPECT_NEAR(length, path.length, 1e-2);
+}
+}
+
+TEST(PathfinderTest, MatchesDijkstraAcrossChunks) {
+  std::mt19937 random(3);
+  support::TestWorld testWorld(MAP_SIZE);
+  world::Map& map = testWorld.getWorld().getMap();
+  const glm::ivec2 size = MAP_SIZE * (int)data::Chunk::SIDE_LENGTH;
+  for (unsigned int i = 0; i < 700; i++) {
+    map.addBuilding(support::makeBuilding(random() % (size.x - 6), random() % (size.y - 6), 1 + random() % 6,
+                                          1 + random() % 6));
+  }
+  world::Pathfinder pathfinder(map);
+
+  std::vector<world::Pathfinder::Query> queries;
+  while (queries.size() < 60) {
+    const glm::ivec2 from = glm::ivec2(random() % size.x, random() % size.y);
+    const glm::ivec2 to = glm::ivec2(random() % size.x, random() % size.y);
+    if (pathfinder.isFree(from) && pathfinder.isFree(to)) {
+      queries.push_back(world::Pathfinder::Query{from, to});
+    }
+  }
+
+  unsigned int found = 0;
+  world::Pathfinder::Path path;
+  for (const world::Pathfinder::Query& query : queries) {
+    const float expected = getExpectedLength(pathfinder, query.from, query.to);
+    ASSERT_EQ(!std::isinf(expected), pathfinder.findPath(query.from, query.to, path));
+    if (path.found) {
+      found++;
+      EXPECT_EQ(query.from, path.waypoints.front());
+      EXPECT_EQ(query.to, path.waypoints.back());
+      EXPECT_NEAR(expected, path.length, 1e-2);
+      checkPath(pathfinder, path);
+    }
+  }
+  EXPECT_GT(found, 40u);
+
+  // Batch gives the same results on any number of threads
+  std::vector<world::Pathfinder::Path> paths;
+  pathfinder.findPaths(queries, paths, 3);
+  ASSERT_EQ(queries.size(), paths.size());
+  for (unsigned int i = 0; i < queries.size(); i++) {
+    pathfinder.findPath(queries[i].from, queries[i].to, path);
+    EXPECT_EQ(path.found, paths[i].found);
+    EXPECT_EQ(path.length, paths[i].length);
+  }
+}
+
+TEST(PathfinderTest, UpdateSeesNewBuildings) {
+  support::TestWorld testWorld(MAP_SIZE);
+  world::Map& map = testWorld.getWorld().getMap();
+  world::Pathfinder pathfinder(map);
+  world::Pathfinder::Path path;
+  ASSERT_TRUE(pathfinder.findPath(glm::ivec2(10, 10), glm::ivec2(150, 10), path));
+  EXPECT_FLOAT_EQ(140, path.length);
+  EXPECT_EQ(2u, path.waypoints.size());
+  EXPECT_FALSE(pathfinder.findPath(glm::ivec2(10, 10), glm::ivec2(-1, 10), path));
+
+  // Wall across the whole map on chunk border, then a gate in it
+  map.addBuilding(support::makeBuilding(60, 0, 8, 128));
+  pathfinder.update(glm::ivec2(60, 0), glm::ivec2(67, 127));
+  EXPECT_FALSE(pathfinder.isFree(glm::ivec2(64, 50)));
+  EXPECT_FALSE(pathfinder.findPath(glm::ivec2(10, 10), glm::ivec2(150, 10), path));
+
+  map.removeBuilding(support::makeBuilding(60, 0, 8, 128));
+  map.addBuilding(support::makeBuilding(60, 0, 8, 40));
+  map.addBuilding(support::makeBuilding(60, 41, 8, 87));
+  pathfinder.update(glm::ivec2(60, 0), glm::ivec2(67, 127));
+  ASSERT_TRUE(pathfinder.findPath(glm::ivec2(10, 10), glm::ivec2(150, 10), path));
+  EXPECT_NEAR(getExpectedLength(pathfinder, glm::ivec2(10, 10), glm::ivec2(150, 10)), path.length, 1e-2);
+  checkPath(pathfinder, path);
+}
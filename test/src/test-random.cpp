@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/engine/Random.hpp"
+
+namespace {
+
+std::vector<uint32_t> draw(engine::Random::Stream stream, unsigned int count) {
+  std::vector<uint32_t> result;
+  for (unsigned int i = 0; i < count; i++) {
+    result.push_back(stream());
+  }
+  return result;
+}
+}
+
+// Known answers of Philox4x32-10 from the reference implementation
+TEST(RandomTest, PhiloxMatchesReference) {
+  typedef engine::Random::Counter Counter;
+  typedef engine::Random::Key Key;
+  EXPECT_EQ((Counter{{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}}),
+            engine::Random::philox(Counter{{0, 0, 0, 0}}, Key{{0, 0}}));
+  EXPECT_EQ((Counter{{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}}),
+            engine::Random::philox(Counter{{0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}},
+                                   Key{{0xffffffff, 0xffffffff}}));
+  EXPECT_EQ((Counter{{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}}),
+            engine::Random::philox(Counter{{0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}},
+                                   Key{{0xa4093822, 0x299f31d0}}));
+}
+
+TEST(RandomTest, StreamsAreReproducibleAndIndependent) {
+  const engine::Random random(123);
+  const engine::RandomSystem system = engine::RandomSystem::WORLD_GENERATOR;
+  const std::vector<uint32_t> expected = draw(random.getStream(system, glm::ivec2(2, 3), 5), 10);
+
+  // Streams are values, order of creation and use does not matter
+  EXPECT_EQ(expected, draw(engine::Random(123).getStream(system, glm::ivec2(2, 3), 5), 10));
+  EXPECT_NE(expected, draw(random.getStream(system, glm::ivec2(3, 2), 5), 10));
+  EXPECT_NE(expected, draw(random.getStream(system, glm::ivec2(2, 3), 6), 10));
+  EXPECT_NE(expected, draw(random.getStream(engine::RandomSystem::SIMULATION, glm::ivec2(2, 3), 5), 10));
+  EXPECT_NE(expected, draw(engine::Random(124).getStream(system, glm::ivec2(2, 3), 5), 10));
+
+  for (unsigned int skip = 0; skip < 10; skip++) {
+    for (unsigned int before = 0; before < 3; before++) {
+      engine::Random::Stream stream = random.getStream(system, glm::ivec2(2, 3), 5);
+      for (unsigned int i = 0; i < before && i < skip; i++) {
+        stream();
+      }
+      stream.discard(skip - std::min(before, skip));
+      EXPECT_EQ(expected[skip], stream()) << "skip " << skip << ", drawn before " << before;
+    }
+  }
+}
+
+TEST(RandomTest, BoundedValuesStayInRange) {
+  engine::Random::Stream stream = engine::Random(1).getStream(engine::RandomSystem::SIMULATION);
+  std::vector<unsigned int> histogram(6, 0);
+  for (unsigned int i = 0; i < 6000; i++) {
+    const uint32_t value = stream.nextBelow(6);
+    ASSERT_LT(value, 6u);
+    histogram[value]++;
+    const float unit = stream.nextFloat();
+    ASSERT_LE(0.f, unit);
+    ASSERT_LT(unit, 1.f);
+  }
+  for (unsigned int count : histogram) {
+    EXPECT_NEAR(1000, count, 150);
+  }
+}
@@ -0,0 +1,41 @@
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/data/RectArray.hpp"
+
+TEST(RectArrayTest, MatchesScalarIntersection) {
+  std::mt19937 random(3);
+  // Sizes around block boundaries, so both full blocks and tails are tested
+  for (unsigned int count : {0u, 1u, 7u, 8u, 9u, 63u, 64u, 65u, 200u}) {
+    data::RectArray array;
+    std::vector<std::pair<glm::ivec2, glm::ivec2>> rects;
+    for (unsigned int i = 0; i < count; i++) {
+      const glm::ivec2 from = glm::ivec2(random() % 100, random() % 100) - glm::ivec2(50, 50);
+      const glm::ivec2 to = from + glm::ivec2(random() % 10, random() % 10);
+      array.add(from, to);
+      rects.push_back(std::make_pair(from, to));
+    }
+    ASSERT_EQ(count, array.size());
+
+    for (unsigned int i = 0; i < 100; i++) {
+      const glm::ivec2 from = glm::ivec2(random() % 120, random() % 120) - glm::ivec2(60, 60);
+      const glm::ivec2 to = from + glm::ivec2(random() % 15, random() % 15);
+      const unsigned int start = random() % (count + 1);
+
+      std::vector<uint64_t> mask;
+      array.getHitMask(from, to, mask);
+      ASSERT_EQ((count + 63) / 64, mask.size());
+      int expectedFirst = -1;
+      for (unsigned int j = 0; j < count; j++) {
+        const bool hit = data::intersects(rects[j].first, rects[j].second, from, to);
+        EXPECT_EQ(hit, (mask[j / 64] >> (j % 64)) & 1);
+        if (hit && start <= j && expectedFirst < 0) {
+          expectedFirst = j;
+        }
+      }
+      EXPECT_EQ(expectedFirst, array.findFirst(from, to, start));
+    }
+  }
+}
@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/data/RoadGraph.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/RoadGraphChecker.hpp"
+#include "../support/RoadStreams.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+std::string join(const std::vector<std::string>& errors) {
+  std::string result;
+  for (const std::string& error : errors) {
+    result += error + "\n";
+  }
+  return result;
+}
+
+std::string describeDifference(const support::TileSet& expected, const support::TileSet& actual) {
+  std::string result;
+  for (const std::pair<int, int>& tile : expected) {
+    if (actual.find(tile) == actual.end()) {
+      result += " missing (" + std::to_string(tile.first) + ", " + std::to_string(tile.second) + ")";
+    }
+  }
+  for (const std::pair<int, int>& tile : actual) {
+    if (expected.find(tile) == expected.end()) {
+      result += " extra (" + std::to_string(tile.first) + ", " + std::to_string(tile.second) + ")";
+    }
+  }
+  return result;
+}
+
+unsigned int countIntersections(const data::RoadGraph& graph) {
+  return std::count_if(graph.getNodes().begin(), graph.getNodes().end(),
+                       [](const data::RoadGraph::Node& node) { return node.isIntersection(); });
+}
+
+std::vector<std::string> describeRoads(world::Map& map) {
+  std::vector<std::string> result;
+  for (data::Chunk* chunk : map.getChunks()) {
+    for (const data::Road& road : chunk->getRoads()) {
+      result.push_back(road.describe());
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+unsigned long countNodes(world::Map& map) {
+  unsigned long result = 0;
+  for (data::Chunk* chunk : map.getChunks()) {
+    result += chunk->getRoadGraph().getNodes().size();
+  }
+  return result;
+}
+
+// Inserts stream through collision checks, verifying graphs after every accepted road
+std::vector<data::Road> insertAndCheck(support::TestWorld& testWorld, const std::vector<data::Road>& stream) {
+  std::vector<data::Road> accepted;
+  support::TileSet expectedTiles;
+  for (const data::Road& road : stream) {
+    if (!testWorld.addRoad(road)) {
+      continue;
+    }
+    accepted.push_back(road);
+    support::addRoadTiles(road, expectedTiles);
+
+    const std::vector<std::string> errors = support::checkRoadGraphs(testWorld.getWorld().getMap());
+    EXPECT_TRUE(errors.empty()) << "After adding " << road.describe() << ":\n" << join(errors);
+    const support::TileSet tiles = support::getRoadTiles(testWorld.getWorld().getMap());
+    EXPECT_TRUE(expectedTiles == tiles) << "After adding " << road.describe() << ":"
+                                        << describeDifference(expectedTiles, tiles);
+    if (!errors.empty() || expectedTiles != tiles) {
+      break;
+    }
+  }
+  return accepted;
+}
+}
+
+TEST(RoadGraphTest, SingleRoad) {
+  data::RoadGraph graph;
+  graph.addRoad(support::makeRoad(2, 2, data::Direction::N, 6));
+
+  EXPECT_EQ(1u, graph.getRoads().size());
+  EXPECT_EQ(2u, graph.getNodes().size());
+  EXPECT_EQ(0u, countIntersections(graph));
+  EXPECT_TRUE(support::checkRoadGraph(graph).empty()) << join(support::checkRoadGraph(graph));
+}
+
+TEST(RoadGraphTest, CrossingSplitsBothRoads) {
+  data::RoadGraph graph;
+  graph.addRoad(support::makeRoad(10, 2, data::Direction::N, 20));
+  graph.addRoad(support::makeRoad(2, 10, data::Direction::W, 20));
+
+  EXPECT_EQ(4u, graph.getRoads().size());
+  EXPECT_EQ(5u, graph.getNodes().size());
+  EXPECT_EQ(1u, countIntersections(graph));
+  EXPECT_TRUE(support::checkRoadGraph(graph).empty()) << join(support::checkRoadGraph(graph));
+}
+
+TEST(RoadGraphTest, TJunctionAndCorner) {
+  data::RoadGraph graph;
+  graph.addRoad(support::makeRoad(2, 10, data::Direction::W, 20));
+  graph.addRoad(support::makeRoad(10, 10, data::Direction::N, 8));
+  graph.addRoad(support::makeRoad(20, 2, data::Direction::N, 10));
+
+  EXPECT_EQ(4u, graph.getRoads().size());
+  EXPECT_EQ(2u, countIntersections(graph));
+  EXPECT_TRUE(support::checkRoadGraph(graph).empty()) << join(support::checkRoadGraph(graph));
+}
+
+TEST(RoadGraphTest, CollinearRoadsMerge) {
+  data::RoadGraph graph;
+  graph.addRoad(support::makeRoad(2, 2, data::Direction::N, 6));
+  graph.addRoad(support::makeRoad(2, 7, data::Direction::N, 6));
+  graph.addRoad(support::makeRoad(2, 4, data::Direction::N, 3));
+
+  ASSERT_EQ(1u, graph.getRoads().size());
+  EXPECT_EQ(11, graph.getRoads().front().length);
+  EXPECT_EQ(2u, graph.getNodes().size());
+  EXPECT_TRUE(support::checkRoadGraph(graph).empty()) << join(support::checkRoadGraph(graph));
+}
+
+TEST(RoadGraphTest, ExtendingThroughIntersection) {
+  data::RoadGraph graph;
+  graph.addRoad(support::makeRoad(2, 10, data::Direction::W, 20));
+  graph.addRoad(support::makeRoad(10, 2, data::Direction::N, 10));
+  graph.addRoad(support::makeRoad(10, 8, data::Direction::N, 12));
+
+  EXPECT_EQ(4u, graph.getRoads().size());
+  EXPECT_EQ(1u, countIntersections(graph));
+  EXPECT_TRUE(support::checkRoadGraph(graph).empty()) << join(support::checkRoadGraph(graph));
+}
+
+TEST(RoadGraphTest, RandomStreamsKeepInvariants) {
+  for (unsigned int seed = 1; seed <= 40; seed++) {
+    SCOPED_TRACE("seed " + std::to_string(seed));
+    support::TestWorld testWorld(glm::ivec2(2, 2));
+    insertAndCheck(testWorld, support::randomRoads(seed, 120, testWorld.getMapSize(), 40));
+  }
+}
+
+TEST(RoadGraphTest, GridStreamsKeepInvariants) {
+  for (unsigned int seed = 1; seed <= 40; seed++) {
+    SCOPED_TRACE("seed " + std::to_string(seed));
+    support::TestWorld testWorld(glm::ivec2(2, 2));
+    insertAndCheck(testWorld, support::gridRoads(seed, 60, testWorld.getMapSize(), 8));
+  }
+}
+
+TEST(RoadGraphTest, InsertionOrderDoesNotMatter) {
+  for (unsigned int seed = 1; seed <= 20; seed++) {
+    SCOPED_TRACE("seed " + std::to_string(seed));
+    support::TestWorld first(glm::ivec2(2, 2));
+    std::vector<data::Road> accepted = insertAndCheck(first, support::gridRoads(seed, 60, first.getMapSize(), 8));
+
+    std::shuffle(accepted.begin(), accepted.end(), std::mt19937(seed));
+    support::TestWorld second(glm::ivec2(2, 2));
+    for (const data::Road& road : accepted) {
+      EXPECT_TRUE(second.addRoad(road)) << road.describe();
+    }
+    EXPECT_EQ(describeRoads(first.getWorld().getMap()), describeRoads(second.getWorld().getMap()));
+  }
+}
+
+TEST(RoadGraphTest, RoadCutByChunkBorderIsStitched) {
+  support::TestWorld testWorld(glm::ivec2(2, 2));
+  ASSERT_TRUE(testWorld.addRoad(support::makeRoad(10, 50, data::Direction::N, 30)));
+
+  const data::RoadGraph& graph = testWorld.getWorld().getMap().getChunk(glm::ivec2(0, 0)).getRoadGraph();
+  const auto border = std::find_if(graph.getNodes().begin(), graph.getNodes().end(),
+                                   [](const data::RoadGraph::Node& node) { return node.nextN != nullptr; });
+  ASSERT_NE(graph.getNodes().end(), border);
+  EXPECT_EQ(glm::ivec2(10, 63), border->position.getGlobal());
+  EXPECT_EQ(glm::ivec2(10, 64), border->nextN->position.getGlobal());
+  EXPECT_EQ(&*border, border->nextN->nextS);
+  EXPECT_TRUE(support::checkRoadGraphs(testWorld.getWorld().getMap()).empty());
+}
+
+TEST(RoadGraphTest, BuildRoadsMatchesAddingOneByOne) {
+  for (unsigned int seed = 1; seed <= 20; seed++) {
+    SCOPED_TRACE("seed " + std::to_string(seed));
+    support::TestWorld first(glm::ivec2(3, 3));
+    const std::vector<data::Road> stream = (seed % 2) ? support::randomRoads(seed, 150, first.getMapSize(), 60)
+                                                      : support::gridRoads(seed, 80, first.getMapSize(), 8);
+    std::vector<data::Road> pieces;
+    for (const data::Road& road : insertAndCheck(first, stream)) {
+      const std::vector<data::Road> split = first.getGeometry().splitRoadByChunks(road);
+      pieces.insert(pieces.end(), split.begin(), split.end());
+    }
+
+    support::TestWorld second(glm::ivec2(3, 3));
+    second.getWorld().getMap().buildRoads(pieces);
+    EXPECT_EQ(describeRoads(first.getWorld().getMap()), describeRoads(second.getWorld().getMap()));
+    EXPECT_EQ(countNodes(first.getWorld().getMap()), countNodes(second.getWorld().getMap()));
+    EXPECT_TRUE(support::checkRoadGraphs(second.getWorld().getMap()).empty())
+        << join(support::checkRoadGraphs(second.getWorld().getMap()));
+  }
+}
+
+TEST(RoadGraphTest, BuildRoadsReplacesExistingRoads) {
+  support::TestWorld first(glm::ivec2(3, 3));
+  support::TestWorld second(glm::ivec2(3, 3));
+  const std::vector<data::Road> old = support::gridRoads(1, 40, first.getMapSize(), 8);
+  const std::vector<data::Road> stream = support::gridRoads(2, 40, first.getMapSize(), 8);
+  ASSERT_FALSE(insertAndCheck(second, old).empty());
+
+  std::vector<data::Road> pieces;
+  for (const data::Road& road : insertAndCheck(first, stream)) {
+    const std::vector<data::Road> split = first.getGeometry().splitRoadByChunks(road);
+    pieces.insert(pieces.end(), split.begin(), split.end());
+  }
+  second.getWorld().getMap().buildRoads(pieces);
+  EXPECT_EQ(describeRoads(first.getWorld().getMap()), describeRoads(second.getWorld().getMap()));
+  EXPECT_EQ(countNodes(first.getWorld().getMap()), countNodes(second.getWorld().getMap()));
+}
@@ -0,0 +1,94 @@
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "../../src/world/RoadNetwork.hpp"
+#include "../support/RoadStreams.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+void expectEqual(const world::RoadNetwork& expected, const world::RoadNetwork& actual) {
+  ASSERT_EQ(expected.getNodes().size(), actual.getNodes().size());
+  for (unsigned int i = 0; i < expected.getNodes().size(); i++) {
+    EXPECT_EQ(expected.getNodes()[i].position, actual.getNodes()[i].position);
+    EXPECT_EQ(expected.getNodes()[i].size, actual.getNodes()[i].size);
+    EXPECT_EQ(expected.getNodes()[i].chunk, actual.getNodes()[i].chunk);
+    EXPECT_EQ(expected.getNodes()[i].index, actual.getNodes()[i].index);
+  }
+  ASSERT_EQ(expected.getRoads().size(), actual.getRoads().size());
+  for (unsigned int i = 0; i < expected.getRoads().size(); i++) {
+    EXPECT_EQ(expected.getRoads()[i].from, actual.getRoads()[i].from);
+    EXPECT_EQ(expected.getRoads()[i].to, actual.getRoads()[i].to);
+    EXPECT_EQ(expected.getRoads()[i].length, actual.getRoads()[i].length);
+    EXPECT_EQ(expected.getRoads()[i].type, actual.getRoads()[i].type);
+  }
+  EXPECT_EQ(expected.getOffsets(), actual.getOffsets());
+  ASSERT_EQ(expected.getEdges().size(), actual.getEdges().size());
+  for (unsigned int i = 0; i < expected.getEdges().size(); i++) {
+    EXPECT_EQ(expected.getEdges()[i].target, actual.getEdges()[i].target);
+    EXPECT_EQ(expected.getEdges()[i].length, actual.getEdges()[i].length);
+    EXPECT_EQ(expected.getEdges()[i].type, actual.getEdges()[i].type);
+    EXPECT_EQ(expected.getEdges()[i].road, actual.getEdges()[i].road);
+  }
+}
+}
+
+TEST(RoadNetworkTest, MatchesRoadGraphs) {
+  support::TestWorld testWorld(glm::ivec2(2, 2));
+  for (const data::Road& road : support::gridRoads(3, 60, testWorld.getMapSize(), 8)) {
+    testWorld.addRoad(road);
+  }
+  world::RoadNetwork network;
+  network.build(testWorld.getWorld().getMap());
+
+  unsigned int nodes = 0, roads = 0;
+  for (const data::Chunk* chunk : testWorld.getWorld().getMap().getChunks()) {
+    nodes += chunk->getRoadGraph().getNodes().size();
+    roads += chunk->getRoadGraph().getRoads().size();
+  }
+  EXPECT_EQ(nodes, network.getNodes().size());
+  EXPECT_EQ(roads, network.getRoads().size());
+  ASSERT_EQ(nodes + 1, network.getOffsets().size());
+
+  // Every edge has its twin going back
+  unsigned int stitches = 0;
+  for (unsigned int node = 0; node < nodes; node++) {
+    for (unsigned int i = network.getOffsets()[node]; i < network.getOffsets()[node + 1]; i++) {
+      const world::RoadNetwork::Edge& edge = network.getEdges()[i];
+      stitches += (edge.road == world::RoadNetwork::NO_ROAD);
+      EXPECT_EQ(data::RoadTypes.Standard.id, edge.type);
+      bool twin = false;
+      for (unsigned int j = network.getOffsets()[edge.target]; j < network.getOffsets()[edge.target + 1]; j++) {
+        twin |= (network.getEdges()[j].target == node && network.getEdges()[j].road == edge.road);
+      }
+      EXPECT_TRUE(twin);
+    }
+  }
+  EXPECT_EQ(2 * roads + stitches, network.getEdges().size());
+  EXPECT_LT(0u, stitches);
+}
+
+TEST(RoadNetworkTest, DumpAndLoad) {
+  support::TestWorld testWorld(glm::ivec2(2, 2));
+  for (const data::Road& road : support::randomRoads(5, 120, testWorld.getMapSize(), 40)) {
+    testWorld.addRoad(road);
+  }
+  world::RoadNetwork network;
+  network.build(testWorld.getWorld().getMap());
+
+  std::stringstream stream;
+  network.dump(stream);
+  world::RoadNetwork loaded;
+  loaded.load(stream);
+  expectEqual(network, loaded);
+
+  const std::string bytes = stream.str();
+  std::istringstream truncated(bytes.substr(0, bytes.size() - 3));
+  EXPECT_THROW(loaded.load(truncated), std::runtime_error);
+  std::istringstream garbage("not a road network");
+  EXPECT_THROW(loaded.load(garbage), std::runtime_error);
+  expectEqual(network, loaded);
+}
@@ -0,0 +1,106 @@
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/data/RectArray.hpp"
+#include "../../src/world/ScenarioGenerator.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+world::settings::Scenario getScenario() {
+  world::settings::Scenario scenario;
+  scenario.width = 4;
+  scenario.height = 3;
+  scenario.roadSpacing = 20;
+  scenario.lotDensity = 0.7f;
+  scenario.buildingsPerChunk = 60;
+  scenario.minBuildingHeight = 2;
+  scenario.maxBuildingHeight = 12;
+  scenario.heightDistribution = world::HeightDistribution::DOWNTOWN;
+  return scenario;
+}
+
+std::vector<std::tuple<long, long, unsigned short, unsigned short, unsigned short>> describe(world::Map& map) {
+  std::vector<std::tuple<long, long, unsigned short, unsigned short, unsigned short>> result;
+  for (const data::Chunk* chunk : map.getChunks()) {
+    for (const data::buildings::Building& building : chunk->getResidentials()) {
+      result.push_back(std::make_tuple(building.x, building.y, building.width, building.length, building.level));
+    }
+  }
+  return result;
+}
+}
+
+TEST(ScenarioGeneratorTest, BuildsWholeCity) {
+  const world::settings::Scenario scenario = getScenario();
+  support::TestWorld testWorld(glm::ivec2(0, 0));
+  world::Map& map = testWorld.getWorld().getMap();
+  world::ScenarioGenerator(7, scenario).generate(map, 2);
+
+  ASSERT_EQ(12u, map.getChunksCount());
+  // Grid lines every 20 tiles, crossing chunk borders
+  for (int line = 0; line <= 240; line += 20) {
+    for (int along : {1, 70, 150}) {
+      for (const glm::ivec2& tile : {glm::ivec2(along, line), glm::ivec2(line, along)}) {
+        if (tile.y <= 180) {
+          const data::Chunk& chunk = map.getChunk(tile / (int)data::Chunk::SIDE_LENGTH);
+          EXPECT_LE(0, chunk.getRoadGraph().getRoadBounds().findFirst(tile, tile)) << tile.x << ", " << tile.y;
+        }
+      }
+    }
+  }
+  unsigned int lotCount = 0;
+  for (const data::Chunk* chunk : map.getChunks()) {
+    lotCount += chunk->getLots().size();
+  }
+  EXPECT_GT(lotCount, 0u);
+  EXPECT_GT(map.getBuildingCount(), 300u);
+
+  for (const data::Chunk* chunk : map.getChunks()) {
+    for (const data::buildings::Building& building : chunk->getResidentials()) {
+      EXPECT_LE(2, building.level);
+      EXPECT_GE(12, building.level);
+      const glm::ivec2 from = glm::ivec2(building.x, building.y);
+      const glm::ivec2 to = from + glm::ivec2(building.width - 1, building.length - 1);
+      for (const data::Chunk* other : map.getChunks()) {
+        EXPECT_EQ(-1, other->getRoadGraph().getRoadBounds().findFirst(from, to));
+      }
+    }
+    const std::vector<data::Lot> lots = chunk->getLots();
+    for (unsigned int i = 0; i < lots.size(); i++) {
+      const data::Lot& lot = lots[i];
+      const glm::ivec2 from = lot.position.getGlobal();
+      for (const data::Chunk* other : map.getChunks()) {
+        EXPECT_EQ(-1, other->getRoadGraph().getRoadBounds().findFirst(from, from + lot.size - 1));
+      }
+      EXPECT_TRUE(chunk->getFrontageIndex().getFrontage(i).hasAccess()) << from.x << ", " << from.y;
+    }
+  }
+}
+
+TEST(ScenarioGeneratorTest, SameSeedGivesSameCity) {
+  support::TestWorld first(glm::ivec2(0, 0));
+  world::ScenarioGenerator(7, getScenario()).generate(first.getWorld().getMap(), 1);
+  support::TestWorld second(glm::ivec2(0, 0));
+  world::ScenarioGenerator(7, getScenario()).generate(second.getWorld().getMap(), 3);
+  support::TestWorld third(glm::ivec2(0, 0));
+  world::ScenarioGenerator(8, getScenario()).generate(third.getWorld().getMap(), 1);
+
+  EXPECT_EQ(describe(first.getWorld().getMap()), describe(second.getWorld().getMap()));
+  EXPECT_NE(describe(first.getWorld().getMap()), describe(third.getWorld().getMap()));
+}
+
+TEST(ScenarioGeneratorTest, ClampsToRendererLimits) {
+  world::settings::Scenario scenario = getScenario();
+  EXPECT_TRUE(world::ScenarioGenerator::clampToLimits(scenario));
+
+  scenario.width = 600;
+  scenario.maxBuildingHeight = 300;
+  EXPECT_FALSE(world::ScenarioGenerator::clampToLimits(scenario));
+  EXPECT_EQ(world::ScenarioGenerator::MAX_SIDE, scenario.width);
+  EXPECT_EQ(3u, scenario.height);
+  EXPECT_EQ(2u, scenario.minBuildingHeight);
+  EXPECT_EQ(world::ScenarioGenerator::MAX_BUILDING_HEIGHT, scenario.maxBuildingHeight);
+}
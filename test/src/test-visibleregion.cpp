@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <glm/ext.hpp>
+
+#include "../../src/world/Frustum.hpp"
+#include "../support/MapObjects.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+void initCamera(world::Camera& camera, glm::vec3 lookAt, float rotationAroundX, float distance = 40) {
+  world::PerspectiveState perspective{glm::radians(45.f), 1.f, 0.1f, 10000.f};
+  data::CameraState state;
+  state.lookAt = lookAt;
+  state.distance = distance;
+  state.rotationAroundX = rotationAroundX;
+  state.rotationAroundY = 0;
+  camera.init(perspective, state);
+}
+}
+
+TEST(VisibleRegionTest, CoversChunksUnderCamera) {
+  support::TestWorld testWorld(glm::ivec2(8, 8));
+  world::World& world = testWorld.getWorld();
+  const glm::vec3 center = glm::vec3(1.5f, 0, 1.5f) * (float)data::Chunk::SIDE_LENGTH;
+
+  // Looking almost straight down sees only ground around the centre of one chunk
+  initCamera(world.getCamera(), center, 1.5f);
+  const world::VisibleRegion& region = world.getVisibleRegion();
+  ASSERT_EQ(1u, region.getChunks().size());
+  EXPECT_TRUE(region.containsChunk(glm::ivec2(1, 1)));
+  EXPECT_LE(region.getFrom().x, (int)center.x);
+  EXPECT_GE(region.getTo().x, (int)center.x);
+
+  // Looking at the horizon, footprint is cut at far plane and spans the map
+  initCamera(world.getCamera(), center, 0.05f);
+  EXPECT_GT(world.getVisibleRegion().getChunks().size(), 8u);
+  EXPECT_TRUE(region.containsChunk(glm::ivec2(1, 1)));
+}
+
+TEST(VisibleRegionTest, RecomputesOnlyAfterCameraChange) {
+  support::TestWorld testWorld(glm::ivec2(4, 4));
+  world::World& world = testWorld.getWorld();
+  initCamera(world.getCamera(), glm::vec3(32, 0, 32), 1.f);
+  world::VisibleRegion region(world.getMap(), world.getCamera());
+
+  EXPECT_TRUE(region.update());
+  const unsigned long version = region.getVersion();
+  EXPECT_FALSE(region.update());
+  EXPECT_EQ(version, region.getVersion());
+
+  world.getCamera().move(glm::vec3(64, 0, 0));
+  EXPECT_TRUE(region.update());
+  EXPECT_NE(version, region.getVersion());
+
+  world.getMap().createChunk(glm::ivec2(4, 0));
+  EXPECT_TRUE(region.update());
+
+  // Same number of new chunks, cached pointers are stale
+  const unsigned int count = world.getMap().getChunksCount();
+  world.getMap().cleanup();
+  for (unsigned int i = 0; i < count; i++) {
+    world.getMap().createChunk(glm::ivec2(i % 4, i / 4));
+  }
+  EXPECT_TRUE(region.update());
+  ASSERT_FALSE(region.getChunks().empty());
+  EXPECT_EQ(world.getMap().getChunks()[region.getChunkIndices()[0]], region.getChunks()[0]);
+}
+
+TEST(VisibleRegionTest, CoversTallBuildingsOffTheGround) {
+  support::TestWorld testWorld(glm::ivec2(6, 6));
+  world::World& world = testWorld.getWorld();
+  world::Map& map = world.getMap();
+  for (int x = 0; x < 6; x++) {
+    for (int y = 0; y < 6; y++) {
+      map.addBuilding(support::makeBuilding(x * 64 + 60, y * 64 + 60, 10, 10, 120));
+    }
+  }
+
+  // Every chunk passing frustum test has to be in the region, for low and high cameras looking around
+  for (float distance : {4.f, 40.f, 300.f}) {
+    for (float rotationAroundX : {0.05f, 0.4f, 1.2f}) {
+      initCamera(world.getCamera(), glm::vec3(200, 0, 150), rotationAroundX, distance);
+      const world::VisibleRegion& region = world.getVisibleRegion();
+      const world::Frustum frustum(world.getCamera().getViewProjectionMatrix());
+      for (unsigned int index : world::cullChunks(map.getChunks(), frustum)) {
+        const glm::ivec2 position = map.getChunks()[index]->getPosition();
+        EXPECT_TRUE(region.containsChunk(position))
+            << position.x << ", " << position.y << " at " << distance << ", " << rotationAroundX;
+      }
+    }
+  }
+}
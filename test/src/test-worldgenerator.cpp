@@ -0,0 +1,65 @@
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../../src/world/WorldGenerator.hpp"
+#include "../support/RoadStreams.hpp"
+#include "../support/TestWorld.hpp"
+
+namespace {
+
+const glm::ivec2 MAP_SIZE = glm::ivec2(4, 3);
+
+std::vector<data::buildings::Building> generate(support::TestWorld& testWorld, unsigned int seed,
+                                                unsigned int threadCount) {
+  world::WorldGenerator::Settings settings;
+  // Dense enough for plenty of conflicts on chunk borders
+  settings.buildingsPerChunk = 400;
+  return world::WorldGenerator(seed, settings).generateBuildings(testWorld.getWorld().getMap(), threadCount);
+}
+
+std::vector<std::tuple<long, long, unsigned short, unsigned short, unsigned short>>
+describe(const std::vector<data::buildings::Building>& buildings) {
+  std::vector<std::tuple<long, long, unsigned short, unsigned short, unsigned short>> result;
+  for (const data::buildings::Building& building : buildings) {
+    result.push_back(std::make_tuple(building.x, building.y, building.width, building.length, building.level));
+  }
+  return result;
+}
+}
+
+TEST(WorldGeneratorTest, SameSeedGivesSameCityOnAnyThreadCount) {
+  support::TestWorld testWorld(MAP_SIZE);
+  for (const data::Road& road : support::gridRoads(3, 20, MAP_SIZE, 16)) {
+    testWorld.addRoad(road);
+  }
+
+  const auto expected = describe(generate(testWorld, 42, 1));
+  ASSERT_FALSE(expected.empty());
+  for (unsigned int threadCount : {2u, 3u, 8u}) {
+    EXPECT_EQ(expected, describe(generate(testWorld, 42, threadCount))) << threadCount << " threads";
+  }
+  EXPECT_NE(expected, describe(generate(testWorld, 43, 1)));
+}
+
+TEST(WorldGeneratorTest, BuildingsDoNotCollide) {
+  support::TestWorld testWorld(MAP_SIZE);
+  for (const data::Road& road : support::gridRoads(5, 20, MAP_SIZE, 16)) {
+    testWorld.addRoad(road);
+  }
+
+  const std::vector<data::buildings::Building> buildings = generate(testWorld, 7, 4);
+  for (const data::buildings::Building& building : buildings) {
+    EXPECT_FALSE(testWorld.getGeometry().checkCollisions(building));
+  }
+
+  // Only the building itself is found in its footprint
+  testWorld.getWorld().getMap().addBuildings(buildings);
+  EXPECT_EQ(buildings.size(), testWorld.getWorld().getMap().getBuildingCount());
+  for (const data::buildings::Building& building : buildings) {
+    const glm::ivec2 from = glm::ivec2(building.x, building.y);
+    const glm::ivec2 to = from + glm::ivec2(building.width - 1, building.length - 1);
+    EXPECT_EQ(1u, testWorld.getGeometry().getBuildings(from, to).size());
+  }
+}
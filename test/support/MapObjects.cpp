@@ -0,0 +1,25 @@
+#include "MapObjects.hpp"
+
+namespace support {
+
+data::Road makeRoad(int x, int y, data::Direction direction, unsigned short length) {
+  data::Road road;
+  road.setType(data::RoadTypes.Standard);
+  road.position.setGlobal(glm::ivec2(x, y));
+  road.direction = direction;
+  road.length = length;
+  return road;
+}
+
+data::buildings::Building makeBuilding(long x, long y, unsigned short width, unsigned short length,
+                                       unsigned short level) {
+  data::buildings::Building building;
+  building.objectId = 0;
+  building.x = x;
+  building.y = y;
+  building.width = width;
+  building.length = length;
+  building.level = level;
+  return building;
+}
+}
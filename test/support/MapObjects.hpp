@@ -0,0 +1,17 @@
+#ifndef SUPPORT_MAPOBJECTS_HPP
+#define SUPPORT_MAPOBJECTS_HPP
+
+#include "../../src/data/Direction.hpp"
+#include "../../src/data/Road.hpp"
+#include "../../src/data/buildings.hpp"
+
+namespace support {
+
+// Standard road starting at given tile
+data::Road makeRoad(int x, int y, data::Direction direction, unsigned short length);
+
+data::buildings::Building makeBuilding(long x, long y, unsigned short width, unsigned short length,
+                                       unsigned short level = 1);
+}
+
+#endif
@@ -0,0 +1,213 @@
+#include "RoadGraphChecker.hpp"
+
+namespace support {
+
+namespace {
+
+typedef data::RoadGraph::Node Node;
+
+std::string describe(const Node& node) {
+  return "Node {(" + std::to_string(node.position.getGlobal().x) + ", " + std::to_string(node.position.getGlobal().y) +
+         "), size: (" + std::to_string(node.size.x) + ", " + std::to_string(node.size.y) + ")}";
+}
+
+glm::ivec2 getEnd(const Node& node) {
+  return node.position.getGlobal() + node.size - glm::ivec2(1, 1);
+}
+
+bool contains(glm::ivec2 from, glm::ivec2 to, glm::ivec2 point) {
+  return from.x <= point.x && point.x <= to.x && from.y <= point.y && point.y <= to.y;
+}
+
+bool intersect(glm::ivec2 aFrom, glm::ivec2 aTo, glm::ivec2 bFrom, glm::ivec2 bTo) {
+  return !(aTo.y < bFrom.y || aFrom.y > bTo.y || aTo.x < bFrom.x || aFrom.x > bTo.x);
+}
+
+// Only pieces cut by chunk border can be shorter than road width
+bool touchesChunkBorder(const data::Road& road) {
+  const glm::ivec2 from = road.position.getLocal();
+  const glm::ivec2 to = from + data::toVector(road.direction) * (road.length - 1);
+  const int last = data::Chunk::SIDE_LENGTH - 1;
+  return (data::Direction::N == road.direction) ? (from.y == 0 || to.y == last) : (from.x == 0 || to.x == last);
+}
+
+bool links(const Node& node, const data::Road* road) {
+  return node.N == road || node.S == road || node.W == road || node.E == road;
+}
+
+void checkLink(const data::RoadGraph& graph, const Node& node, bool has, const data::Road* road, data::Direction dir,
+               bool atStart, const std::string& name, std::vector<std::string>& errors) {
+  if (has != (nullptr != road)) {
+    errors.push_back(describe(node) + ": has" + name + " does not match " + name + " pointer");
+  }
+  if (nullptr == road) {
+    return;
+  }
+
+  const std::vector<data::Road>& roads = graph.getRoads();
+  if (road < roads.data() || roads.data() + roads.size() <= road) {
+    errors.push_back(describe(node) + ": " + name + " points outside of road list");
+    return;
+  }
+
+  if (road->direction != dir) {
+    errors.push_back(describe(node) + ": " + name + " points to " + road->describe());
+  }
+  const glm::ivec2 endpoint = atStart ? road->position.getGlobal() : road->getEnd();
+  if (!contains(node.position.getGlobal(), getEnd(node), endpoint)) {
+    errors.push_back(describe(node) + ": " + name + " points to " + road->describe() + " which does not " +
+                     (atStart ? "start" : "end") + " there");
+  }
+}
+
+// Stitched nodes live in other chunks and point back
+void checkStitch(world::Map& map, const Node& node, const Node* next, const Node* Node::*back,
+                 const std::string& name, const std::string& prefix, std::vector<std::string>& errors) {
+  if (nullptr == next) {
+    return;
+  }
+
+  const data::Chunk* owner = nullptr;
+  for (const data::Chunk* chunk : map.getChunks()) {
+    const std::vector<Node>& nodes = chunk->getRoadGraph().getNodes();
+    if (nodes.data() <= next && next < nodes.data() + nodes.size()) {
+      owner = chunk;
+    }
+  }
+  if (nullptr == owner) {
+    errors.push_back(prefix + describe(node) + ": " + name + " points outside of node lists");
+    return;
+  }
+  if (owner->getPosition() == node.position.getChunk()) {
+    errors.push_back(prefix + describe(node) + ": " + name + " points to the same chunk");
+  }
+  if (next->*back != &node) {
+    errors.push_back(prefix + describe(node) + ": " + name + " is not stitched back");
+  }
+}
+}
+
+std::vector<std::string> checkRoadGraph(const data::RoadGraph& graph) {
+  std::vector<std::string> errors;
+  const std::vector<data::Road>& roads = graph.getRoads();
+  const std::vector<Node>& nodes = graph.getNodes();
+
+  // Node links
+  for (const Node& node : nodes) {
+    checkLink(graph, node, node.hasN, node.N, data::Direction::N, true, "N", errors);
+    checkLink(graph, node, node.hasS, node.S, data::Direction::N, false, "S", errors);
+    checkLink(graph, node, node.hasW, node.W, data::Direction::W, true, "W", errors);
+    checkLink(graph, node, node.hasE, node.E, data::Direction::W, false, "E", errors);
+
+    const bool alongY = node.hasN || node.hasS;
+    const bool alongX = node.hasW || node.hasE;
+    const int degree = node.hasN + node.hasS + node.hasW + node.hasE;
+    if (node.isIntersection()) {
+      if (!alongX || !alongY) {
+        errors.push_back(describe(node) + ": intersection without perpendicular roads");
+      }
+    } else {
+      // Road cut by chunk border can start and end on the same row
+      const bool singleRow = (degree == 2) && ((node.hasN && node.N == node.S && node.N->length == 1) ||
+                                               (node.hasW && node.W == node.E && node.W->length == 1));
+      if (degree != 1 && !singleRow) {
+        errors.push_back(describe(node) + ": dead end with degree " + std::to_string(degree));
+      }
+      if ((node.size.x > node.size.y && alongX) || (node.size.x < node.size.y && alongY)) {
+        errors.push_back(describe(node) + ": dead end across its road");
+      }
+    }
+  }
+
+  // Nodes do not overlap
+  for (size_t i = 0; i < nodes.size(); i++) {
+    for (size_t j = i + 1; j < nodes.size(); j++) {
+      if (intersect(nodes[i].position.getGlobal(), getEnd(nodes[i]), nodes[j].position.getGlobal(), getEnd(nodes[j]))) {
+        errors.push_back(describe(nodes[i]) + " overlaps " + describe(nodes[j]));
+      }
+    }
+  }
+
+  // Every road is pinned on both ends
+  for (const data::Road& road : roads) {
+    const data::Road* pointer = &road;
+    unsigned int starts = 0, ends = 0;
+    for (const Node& node : nodes) {
+      starts += (node.N == pointer || node.W == pointer);
+      ends += (node.S == pointer || node.E == pointer);
+    }
+    if (starts != 1 || ends != 1) {
+      errors.push_back(road.describe() + ": pinned to " + std::to_string(starts) + " start and " +
+                       std::to_string(ends) + " end nodes");
+    }
+    if (road.length < road.getType().width && !touchesChunkBorder(road)) {
+      errors.push_back(road.describe() + ": shorter than its width");
+    }
+  }
+
+  // Roads overlap only on nodes they share
+  for (size_t i = 0; i < roads.size(); i++) {
+    for (size_t j = i + 1; j < roads.size(); j++) {
+      const glm::ivec2 aFrom = roads[i].position.getGlobal();
+      const glm::ivec2 bFrom = roads[j].position.getGlobal();
+      if (!intersect(aFrom, roads[i].getEnd(), bFrom, roads[j].getEnd())) {
+        continue;
+      }
+
+      const glm::ivec2 from = glm::max(aFrom, bFrom);
+      const glm::ivec2 to = glm::min(roads[i].getEnd(), roads[j].getEnd());
+      bool shared = false;
+      for (const Node& node : nodes) {
+        if (contains(node.position.getGlobal(), getEnd(node), from) &&
+            contains(node.position.getGlobal(), getEnd(node), to) && links(node, &roads[i]) &&
+            links(node, &roads[j])) {
+          shared = true;
+        }
+      }
+      if (!shared) {
+        errors.push_back(roads[i].describe() + " overlaps " + roads[j].describe());
+      }
+    }
+  }
+
+  return errors;
+}
+
+std::vector<std::string> checkRoadGraphs(world::Map& map) {
+  std::vector<std::string> errors;
+  for (data::Chunk* chunk : map.getChunks()) {
+    const std::string prefix =
+        "Chunk (" + std::to_string(chunk->getPosition().x) + ", " + std::to_string(chunk->getPosition().y) + "): ";
+    for (const std::string& error : checkRoadGraph(chunk->getRoadGraph())) {
+      errors.push_back(prefix + error);
+    }
+    for (const Node& node : chunk->getRoadGraph().getNodes()) {
+      checkStitch(map, node, node.nextN, &Node::nextS, "nextN", prefix, errors);
+      checkStitch(map, node, node.nextS, &Node::nextN, "nextS", prefix, errors);
+      checkStitch(map, node, node.nextW, &Node::nextE, "nextW", prefix, errors);
+      checkStitch(map, node, node.nextE, &Node::nextW, "nextE", prefix, errors);
+    }
+  }
+  return errors;
+}
+
+void addRoadTiles(const data::Road& road, TileSet& tiles) {
+  const glm::ivec2 from = road.position.getGlobal();
+  const glm::ivec2 to = road.getEnd();
+  for (int x = from.x; x <= to.x; x++) {
+    for (int y = from.y; y <= to.y; y++) {
+      tiles.insert(std::make_pair(x, y));
+    }
+  }
+}
+
+TileSet getRoadTiles(world::Map& map) {
+  TileSet tiles;
+  for (data::Chunk* chunk : map.getChunks()) {
+    for (const data::Road& road : chunk->getRoads()) {
+      addRoadTiles(road, tiles);
+    }
+  }
+  return tiles;
+}
+}
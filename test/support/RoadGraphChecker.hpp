@@ -0,0 +1,30 @@
+#ifndef SUPPORT_ROADGRAPHCHECKER_HPP
+#define SUPPORT_ROADGRAPHCHECKER_HPP
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../../src/data/RoadGraph.hpp"
+#include "../../src/world/Map.hpp"
+
+namespace support {
+
+typedef std::set<std::pair<int, int>> TileSet;
+
+/**
+ * Checks structural invariants of the graph. Returns list of violations, empty if graph is valid.
+ */
+std::vector<std::string> checkRoadGraph(const data::RoadGraph& graph);
+
+/**
+ * Checks every chunk of the map and links between chunks, prefixing violations with chunk position.
+ */
+std::vector<std::string> checkRoadGraphs(world::Map& map);
+
+void addRoadTiles(const data::Road& road, TileSet& tiles);
+TileSet getRoadTiles(world::Map& map);
+}
+
+#endif
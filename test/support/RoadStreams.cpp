@@ -0,0 +1,76 @@
+#include "RoadStreams.hpp"
+
+#include <algorithm>
+
+#include "MapObjects.hpp"
+
+namespace support {
+
+namespace {
+// Keeps the road inside the map and its width inside single row of chunks, Geometry::splitRoadByChunks() cuts roads
+// only along their direction
+data::Road makeRoad(glm::ivec2 position, bool north, unsigned short length, glm::ivec2 mapTiles) {
+  const int width = data::RoadTypes.Standard.width;
+  const int side = data::Chunk::SIDE_LENGTH;
+  position = glm::min(position, mapTiles - glm::ivec2(width, width));
+  if (north) {
+    position.x -= std::max(0, position.x % side + width - side);
+  } else {
+    position.y -= std::max(0, position.y % side + width - side);
+  }
+  const int available = north ? mapTiles.y - position.y : mapTiles.x - position.x;
+  length = std::min<int>(length, available);
+
+  return support::makeRoad(position.x, position.y, north ? data::Direction::N : data::Direction::W, length);
+}
+}
+
+std::vector<data::Road> randomRoads(unsigned int seed, unsigned int count, glm::ivec2 mapSize,
+                                    unsigned short maxLength) {
+  std::mt19937 random(seed);
+  const glm::ivec2 mapTiles = mapSize * (int)data::Chunk::SIDE_LENGTH;
+  const int width = data::RoadTypes.Standard.width;
+
+  std::vector<data::Road> result;
+  result.reserve(count);
+  for (unsigned int i = 0; i < count; i++) {
+    const bool north = random() % 2;
+    const unsigned short length = width + random() % (maxLength - width + 1);
+    const glm::ivec2 position = glm::ivec2(random() % mapTiles.x, random() % mapTiles.y);
+    result.push_back(makeRoad(position, north, length, mapTiles));
+  }
+  return result;
+}
+
+std::vector<data::Road> decodeRoads(const uint8_t* bytes, size_t size, glm::ivec2 mapSize) {
+  const glm::ivec2 mapTiles = mapSize * (int)data::Chunk::SIDE_LENGTH;
+  const int width = data::RoadTypes.Standard.width;
+
+  std::vector<data::Road> result;
+  for (size_t i = 0; i + 4 <= size; i += 4) {
+    const bool north = bytes[i] & 1;
+    const unsigned short length = width + bytes[i + 1] % mapTiles.x;
+    const glm::ivec2 position = glm::ivec2(bytes[i + 2] % mapTiles.x, bytes[i + 3] % mapTiles.y);
+    result.push_back(makeRoad(position, north, length, mapTiles));
+  }
+  return result;
+}
+
+std::vector<data::Road> gridRoads(unsigned int seed, unsigned int count, glm::ivec2 mapSize, unsigned short spacing) {
+  std::mt19937 random(seed);
+  const glm::ivec2 mapTiles = mapSize * (int)data::Chunk::SIDE_LENGTH;
+  const glm::ivec2 cells = mapTiles / (int)spacing;
+  const int width = data::RoadTypes.Standard.width;
+
+  std::vector<data::Road> result;
+  result.reserve(count);
+  for (unsigned int i = 0; i < count; i++) {
+    const bool north = random() % 2;
+    const int cellsLong = 1 + random() % (north ? cells.y : cells.x);
+    const unsigned short length = cellsLong * spacing + width;
+    const glm::ivec2 position = glm::ivec2(random() % cells.x, random() % cells.y) * (int)spacing;
+    result.push_back(makeRoad(position, north, length, mapTiles));
+  }
+  return result;
+}
+}
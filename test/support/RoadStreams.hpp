@@ -0,0 +1,31 @@
+#ifndef SUPPORT_ROADSTREAMS_HPP
+#define SUPPORT_ROADSTREAMS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "../../src/data/Chunk.hpp"
+#include "../../src/data/Road.hpp"
+
+namespace support {
+
+/**
+ * Random axis-aligned roads inside map of given size (in chunks). Same seed gives the same stream on every platform.
+ */
+std::vector<data::Road> randomRoads(unsigned int seed, unsigned int count, glm::ivec2 mapSize,
+                                    unsigned short maxLength);
+
+/**
+ * Roads decoded from arbitrary bytes, 4 bytes per road. Used by fuzz driver.
+ */
+std::vector<data::Road> decodeRoads(const uint8_t* bytes, size_t size, glm::ivec2 mapSize);
+
+/**
+ * Roads snapped to a grid of given spacing, so they meet mostly on intersections.
+ */
+std::vector<data::Road> gridRoads(unsigned int seed, unsigned int count, glm::ivec2 mapSize, unsigned short spacing);
+}
+
+#endif
@@ -0,0 +1,42 @@
+#include "TestWorld.hpp"
+
+namespace support {
+
+TestWorld::TestWorld(glm::ivec2 mapSize)
+    : mapSize(mapSize), logger(std::chrono::high_resolution_clock::now(), std::cerr), engine(gameSettings, logger) {
+  logger.setLoggingLevel(engine::LoggingLevel::WARN);
+  geometry.init(engine, world);
+  for (int x = 0; x < mapSize.x; x++) {
+    for (int y = 0; y < mapSize.y; y++) {
+      world.getMap().createChunk(glm::ivec2(x, y));
+    }
+  }
+}
+
+TestWorld::~TestWorld() {
+  world.cleanup();
+}
+
+world::World& TestWorld::getWorld() {
+  return world;
+}
+
+world::Geometry& TestWorld::getGeometry() {
+  return geometry;
+}
+
+glm::ivec2 TestWorld::getMapSize() const {
+  return mapSize;
+}
+
+bool TestWorld::addRoad(const data::Road& road) {
+  const std::vector<data::Road> toInsert = geometry.splitRoadByChunks(road);
+  for (const data::Road& road : toInsert) {
+    if (geometry.checkCollisions(road)) {
+      return false;
+    }
+  }
+  world.getMap().addRoads(toInsert);
+  return true;
+}
+}
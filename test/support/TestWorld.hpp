@@ -0,0 +1,41 @@
+#ifndef SUPPORT_TESTWORLD_HPP
+#define SUPPORT_TESTWORLD_HPP
+
+#include <iostream>
+
+#include "../../src/engine/Engine.hpp"
+#include "../../src/engine/Logger.hpp"
+#include "../../src/settings.hpp"
+#include "../../src/world/Geometry.hpp"
+#include "../../src/world/World.hpp"
+
+namespace support {
+
+/**
+ * World with engine and geometry set up, without window and renderer.
+ */
+class TestWorld {
+
+public:
+  TestWorld(glm::ivec2 mapSize);
+  ~TestWorld();
+
+  world::World& getWorld();
+  world::Geometry& getGeometry();
+  glm::ivec2 getMapSize() const;
+
+  // Same path as MapState::addRoadIfNoCollisions()
+  bool addRoad(const data::Road& road);
+
+protected:
+  glm::ivec2 mapSize;
+
+  settings gameSettings;
+  engine::Logger logger;
+  engine::Engine engine;
+  world::World world;
+  world::Geometry geometry;
+};
+}
+
+#endif